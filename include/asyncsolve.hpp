@@ -0,0 +1,120 @@
+//
+// FILENAME: asyncsolve.hpp | Shifting Stones Search
+// DESCRIPTION: Non-blocking (board, card) queries with cancellation and deadlines
+// CREATED: 2026-10-21 @ 11:40 AM
+//
+
+#pragma once
+
+#include <coroutine>
+#include <future>
+#include <stop_token>
+#include <string>
+
+#include "decl.h"
+#include "neighbors.hpp"
+#include "solver.hpp"
+#include "threadpool.hpp"
+#include "transposition.hpp"
+
+namespace asyncsolve {
+	/**
+	 * @struct Options
+	 * @brief Settings for a single background query
+	 */
+	struct Options {
+		solver::clock_type::time_point 	deadline = solver::clock_type::time_point::max(); // The time the search must give up by
+		std::size_t 					maxNodes = 0; 	// The most states to expand, or 0 for no limit
+		std::size_t 					maxMemory = 0; 	// The most bytes of search state, or 0 for no limit
+		const neighbors::NeighborTable* table = nullptr; // An optional neighbor table. It must outlive the query.
+		transposition::TranspositionTable* transpositions = nullptr; // If set, the query runs `idastar::solve` with this
+																	 // shared table instead of a breadth-first search
+	};
+
+	/**
+	 * @brief A query running in the background
+	 *
+	 * @note  Dropping or cancelling a query never blocks. Either one requests a stop, which the search notices at
+	 * 		  its next budget check before freeing its worker.
+	 */
+	class PendingSolve {
+	public:
+		PendingSolve() = default;
+		PendingSolve(std::future<solver::Solution> result, std::stop_source stop):
+			result(std::move(result)),
+			stop(std::move(stop)) {}
+
+		PendingSolve(PendingSolve&&) = default;
+		PendingSolve(const PendingSolve&) = delete;
+		PendingSolve& operator=(const PendingSolve&) = delete;
+
+		/**
+		 * @brief Cancel the query being replaced if its result was never taken
+		 */
+		PendingSolve& operator=(PendingSolve&& other) {
+			if (this != &other) {
+				abandon();
+				result = std::move(other.result);
+				stop = std::move(other.stop);
+			}
+
+			return *this;
+		}
+
+		~PendingSolve() { abandon(); }
+
+		void cancel() { stop.request_stop(); }
+		bool valid() const { return result.valid(); }
+		bool ready() const { return result.wait_for(std::chrono::seconds(0)) == std::future_status::ready; }
+
+		template<class Rep, class Period>
+		std::future_status wait_for(const std::chrono::duration<Rep, Period>& timeout) const {
+			return result.wait_for(timeout);
+		}
+
+		solver::Solution get() { return result.get(); }
+		std::future<solver::Solution>& future() { return result; }
+
+	private:
+		std::future<solver::Solution> 	result;
+		std::stop_source 				stop;
+
+		void abandon() {
+			if (result.valid()) {
+				stop.request_stop();
+			}
+		}
+	};
+
+	PendingSolve solveAsync(threadpool::ThreadPool& pool, board_t board, const std::string& target, const Options& options = {});
+
+	/**
+	 * @brief Awaits a query from a coroutine
+	 *
+	 * @note  The coroutine is suspended while the search runs and resumed on the pool worker that finished it.
+	 * 		  Cancellation comes from the stop token passed in, so a coroutine's own stop source can end it.
+	 */
+	class SolveAwaiter {
+	public:
+		SolveAwaiter(threadpool::ThreadPool& pool, board_t board, std::string target, const Options& options, std::stop_token stop):
+			pool(pool),
+			board(board),
+			target(std::move(target)),
+			options(options),
+			stop(std::move(stop)) {}
+
+		bool await_ready() const noexcept { return false; }
+		void await_suspend(std::coroutine_handle<> handle);
+		solver::Solution await_resume() { return std::move(result); }
+
+	private:
+		threadpool::ThreadPool& pool;
+		board_t 				board;
+		std::string 			target;
+		Options 				options;
+		std::stop_token 		stop;
+		solver::Solution 		result;
+	};
+
+	SolveAwaiter solveAwaitable(threadpool::ThreadPool& pool, board_t board, const std::string& target, const Options& options = {}, std::stop_token stop = {});
+}
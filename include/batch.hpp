@@ -0,0 +1,73 @@
+//
+// FILENAME: batch.hpp | Shifting Stones Search
+// DESCRIPTION: Solve large batches of (board, card) queries
+// CREATED: 2026-10-20 @ 3:10 PM
+//
+
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "decl.h"
+#include "neighbors.hpp"
+#include "policy.hpp"
+
+namespace batch {
+	/**
+	 * @brief The number of bits used to encode a single move
+	 */
+	const int MOVE_BITS = 5;
+
+	/**
+	 * @brief The largest number of moves that fit in an encoded move list
+	 *
+	 * @note  No state is more than 10 moves from any card, so every optimal solution fits
+	 */
+	const int MAX_ENCODED_MOVES = 64 / MOVE_BITS;
+
+	/**
+	 * @brief The move count reported for queries with no solution
+	 */
+	const uint8_t UNSOLVED = 0xFF;
+
+	uint64_t encodeMoves(const std::vector<int>& moves);
+	std::vector<int> decodeMoves(uint64_t encoded, int count);
+
+	/**
+	 * @struct Options
+	 * @brief Settings for a batch engine
+	 */
+	struct Options {
+		std::string policyDirectory = ""; 	// A directory of stored policy tables to load before building, if any
+		std::size_t maxTables = 16; 		// The number of policy tables (~10 MB each) kept between batches
+		unsigned 	threads = 0; 			// The number of worker threads, or 0 for one per hardware thread
+	};
+
+	/**
+	 * @brief Answers batches of independent (board, card) queries
+	 *
+	 * @note  Queries are grouped by card so each card's policy table is loaded or built once per batch. The
+	 * 		  queries of a card are then answered in parallel with one table read per move. Recently used tables
+	 * 		  are kept between batches.
+	 */
+	class BatchEngine {
+	public:
+		BatchEngine(const neighbors::NeighborTable& table, const Options& options = {});
+
+		void solve(const board_t* boards, const int* cards, std::size_t count, uint8_t* moveCounts, uint64_t* moveLists);
+
+	private:
+		using cached_table = std::pair<int, std::unique_ptr<policy::PolicyTable>>;
+
+		const neighbors::NeighborTable& table;
+		Options 						options;
+		std::list<cached_table> 		tables; // Most recently used first
+
+		const policy::PolicyTable& policyFor(int card);
+	};
+}
@@ -0,0 +1,87 @@
+//
+// FILENAME: bitbfs.hpp | Shifting Stones Search
+// DESCRIPTION: Set-at-a-time breadth-first search over bitsets of state indices
+// CREATED: 2026-10-19 @ 1:05 PM
+//
+
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+#include "decl.h"
+#include "neighbors.hpp"
+
+namespace bitbfs {
+	/**
+	 * @brief The number of 64-bit words needed to hold one bit per board state
+	 */
+	const std::size_t STATE_WORDS = (MAX_BOARD_STATES + 63) / 64;
+
+	/**
+	 * @brief A set of state indices stored as one bit per board state (~315 KB)
+	 */
+	class StateSet {
+	public:
+		StateSet():
+			words(STATE_WORDS, 0)
+		{}
+
+		/**
+		 * @brief Add a state to the set
+		 */
+		inline void set(uint32_t index) {
+			words[index / 64] |= 1ULL << (index % 64);
+		}
+
+		/**
+		 * @brief Check if a state is in the set
+		 */
+		inline bool test(uint32_t index) const {
+			return (words[index / 64] >> (index % 64)) & 1;
+		}
+
+		/**
+		 * @brief Call a function on every state index in the set, in ascending order
+		 *
+		 * @param 	visit 	The function to call
+		 */
+		template<class Visitor>
+		void forEach(Visitor&& visit) const {
+			for (std::size_t i = 0; i < STATE_WORDS; i++) {
+				for (uint64_t word = words[i]; word != 0; word &= word - 1) {
+					visit((uint32_t)(64 * i + std::countr_zero(word)));
+				}
+			}
+		}
+
+		std::size_t count() const;
+		bool empty() const;
+
+		StateSet& operator|=(const StateSet& other);
+		StateSet& operator&=(const StateSet& other);
+		StateSet& subtract(const StateSet& other);
+
+		/**
+		 * @brief Get the raw words of the set
+		 */
+		inline uint64_t* data() {
+			return words.data();
+		}
+
+		/**
+		 * @brief Get the raw words of the set
+		 */
+		inline const uint64_t* data() const {
+			return words.data();
+		}
+
+	private:
+		std::vector<uint64_t> words;
+	};
+
+	StateSet expand(const neighbors::NeighborTable& table, const StateSet& frontier, const StateSet& visited, unsigned threads = 0);
+	std::vector<StateSet> levels(const neighbors::NeighborTable& table, const StateSet& start, int maxDepth = -1, unsigned threads = 0);
+	StateSet reachableWithin(const neighbors::NeighborTable& table, const StateSet& start, int moves, unsigned threads = 0);
+}
@@ -0,0 +1,33 @@
+//
+// FILENAME: dedup.hpp | Shifting Stones Search
+// DESCRIPTION: Sort-based deduplication of breadth-first levels
+// CREATED: 2026-10-18 @ 11:02 AM
+//
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "decl.h"
+#include "frontier.hpp"
+
+namespace dedup {
+	/**
+	 * @brief The number of key bits sorted per radix pass
+	 *
+	 * @note  Three passes cover the full 27-bit board
+	 */
+	const int RADIX_BITS = 9;
+
+	/**
+	 * @brief The number of buckets in a single radix pass
+	 */
+	const int RADIX_BUCKETS = 1 << RADIX_BITS;
+
+	void radixSort(std::vector<board_t>& boards);
+	void sortUnique(std::vector<board_t>& boards);
+	void subtract(std::vector<board_t>& boards, const std::vector<board_t>& visited);
+
+	std::vector<frontier::CompressedFrontier> levels(const std::vector<board_t>& start, int maxDepth = -1, std::size_t chunkSize = 1UL << 22);
+}
@@ -0,0 +1,52 @@
+//
+// FILENAME: difficulty.hpp | Shifting Stones Search
+// DESCRIPTION: Exact solution-length statistics of every card over every starting board
+// CREATED: 2026-10-25 @ 10:05 AM
+//
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "decl.h"
+#include "neighbors.hpp"
+
+namespace difficulty {
+	/**
+	 * @brief The longest solution length a report has room for
+	 *
+	 * @note  20 is the largest eccentricity `msbfs` finds in the state graph, so longer solutions aren't expected.
+	 * 		  Any that occur are counted in `CardReport::overflow` instead of the histogram, and such reports aren't
+	 * 		  written.
+	 */
+	const int MAX_DISTANCE = 20;
+
+	/**
+	 * @brief The number of worst-case boards kept for each card
+	 */
+	const std::size_t MAX_WORST = 8;
+
+	/**
+	 * @struct CardReport
+	 * @brief How hard one card is to complete from every starting board
+	 */
+	struct CardReport {
+		std::string 						  card;
+		std::array<uint32_t, MAX_DISTANCE + 1> histogram = {}; 	// The number of boards whose best solution takes each number of moves
+		uint32_t 							  unsolvable = 0; 	// The boards that can't reach the card
+		uint32_t 							  overflow = 0; 	// The boards whose best solution is longer than `MAX_DISTANCE`
+		int 								  maxDistance = 0; 	// The longest best solution
+		double 								  meanDistance = 0; // The average best solution over the solvable boards
+		uint32_t 							  worstCount = 0; 	// The boards at `maxDistance`
+		std::vector<board_t> 				  worstBoards; 		// The first `MAX_WORST` of them, in `BOARD_STATES` order
+	};
+
+	std::vector<CardReport> sweep(const neighbors::NeighborTable& table, const std::vector<std::string>& cards = {}, unsigned threads = 0);
+
+	bool overflows(const std::vector<CardReport>& reports);
+	bool writeCSV(const std::vector<CardReport>& reports, const std::string& path);
+	bool writeBinary(const std::vector<CardReport>& reports, const std::string& path);
+}
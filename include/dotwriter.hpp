@@ -0,0 +1,65 @@
+//
+// FILENAME: dotwriter.hpp | Shifting Stones Search
+// DESCRIPTION: Stream Graphviz DOT code for the search tree and state graph
+// CREATED: 2026-10-22 @ 4:40 PM
+//
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+
+#include "decl.h"
+#include "neighbors.hpp"
+
+namespace dotwriter {
+	/**
+	 * @brief The size of the output buffer
+	 */
+	const std::size_t BUFFER_SIZE = 1UL << 20;
+
+	/**
+	 * @brief The size of a formatted board label: 9 tiles of 3 bits, 6 spaces, 2 escaped newlines and a terminator
+	 */
+	const std::size_t LABEL_SIZE = 27 + 6 + 2 * 2 + 1;
+
+	/**
+	 * @brief Writes a DOT graph one node or edge at a time
+	 *
+	 * @note  Nothing is kept per node, so a graph of any size is written in constant memory. Labels use the same
+	 * 		  3x3 grid of tile bits as `TreeGraph::writeGVDOT`.
+	 */
+	class DotWriter {
+	public:
+		explicit DotWriter(const std::string& path, bool directed = false);
+		~DotWriter();
+
+		DotWriter(const DotWriter&) = delete;
+		DotWriter& operator=(const DotWriter&) = delete;
+
+		/**
+		 * @brief Check if the file was opened and every write so far succeeded
+		 */
+		inline bool good() const {
+			return file && !failed;
+		}
+
+		void node(uint64_t id, board_t board);
+		void edge(uint64_t from, uint64_t to, int move = 0);
+		bool close();
+
+	private:
+		FILE* 					file;
+		bool 					directed;
+		bool 					failed = false;
+		std::unique_ptr<char[]> buffer; 			// The stdio buffer behind `file`
+		char 					label[LABEL_SIZE]; 	// Reused for every node label
+
+		const char* formatLabel(board_t board);
+	};
+
+	bool writeTree(const tree_t tree, const std::string& path, int height = TREE_GEN_HEIGHT);
+	bool writeStateGraph(const neighbors::NeighborTable& table, const std::string& path);
+}
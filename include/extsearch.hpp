@@ -0,0 +1,123 @@
+//
+// FILENAME: extsearch.hpp | Shifting Stones Search
+// DESCRIPTION: External-memory breadth-first search over board states
+// CREATED: 2026-10-18 @ 9:12 AM
+//
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "decl.h"
+#include "frontier.hpp"
+#include "solver.hpp"
+
+namespace extsearch {
+	/**
+	 * @brief The default number of bytes buffered by each open run file
+	 */
+	const std::size_t IO_BUFFER = 1UL << 20;
+
+	/**
+	 * @struct Options
+	 * @brief Settings for an external-memory search
+	 */
+	struct Options {
+		std::string directory = "."; 		// The directory each search creates its own working directory in
+		std::size_t chunkSize = 1UL << 22; 	// The number of boards buffered in memory before spilling a run
+		std::size_t mergeFanIn = 64; 		// The most runs merged at once. More runs are merged over several passes.
+		std::size_t ioBuffer = IO_BUFFER; 	// The number of bytes buffered by each open run file
+		int 		maxDepth = -1; 			// The deepest level to expand, or -1 for no limit
+		bool 		keepLevels = false; 	// Keep the working directory and its level files after the search returns
+	};
+
+	/**
+	 * @struct LevelInfo
+	 * @brief A single breadth-first level stored on disk
+	 */
+	struct LevelInfo {
+		int 		depth; 	// The distance of every board in the level from the start set
+		std::size_t count; 	// The number of boards in the level
+		std::string path; 	// The run file holding the level
+	};
+
+	/**
+	 * @brief Sequentially write a sorted run of boards to disk as compressed frontier blocks
+	 */
+	class RunWriter {
+	public:
+		explicit RunWriter(const std::string& path, std::size_t bufferBytes = IO_BUFFER);
+		~RunWriter();
+
+		RunWriter(const RunWriter&) = delete;
+		RunWriter& operator=(const RunWriter&) = delete;
+
+		void push(board_t board);
+		void close();
+
+		/**
+		 * @brief Get the number of boards written to the run
+		 */
+		inline std::size_t size() const {
+			return count;
+		}
+
+		/**
+		 * @brief Check if the file was opened and every write so far succeeded
+		 */
+		inline bool good() const {
+			return !failed;
+		}
+
+	private:
+		FILE* 				  file;
+		std::vector<board_t>  pending;
+		std::vector<uint32_t> buffer;
+		std::size_t 		  bufferBytes; 	// The buffered bytes that trigger a write
+		std::size_t 		  count = 0;
+		bool 				  failed = false;
+
+		void flush();
+	};
+
+	/**
+	 * @brief Sequentially read a run written by `RunWriter`
+	 */
+	class RunReader {
+	public:
+		explicit RunReader(const std::string& path, std::size_t bufferBytes = IO_BUFFER);
+		~RunReader();
+
+		RunReader(const RunReader&) = delete;
+		RunReader& operator=(const RunReader&) = delete;
+
+		bool next(board_t& board);
+
+		/**
+		 * @brief Check if the file was opened and every read so far succeeded
+		 */
+		inline bool good() const {
+			return !failed;
+		}
+
+	private:
+		FILE* 				  file;
+		std::vector<uint32_t> buffer;
+		std::size_t 		  position = 0;
+		std::size_t 		  length = 0;
+		board_t 			  block[frontier::BLOCK_SIZE];
+		std::size_t 		  blockPosition = 0;
+		std::size_t 		  blockLength = 0;
+		bool 				  failed = false;
+
+		bool fill(std::size_t words);
+	};
+
+	std::vector<LevelInfo> explore(const std::vector<board_t>& start, const Options& options = {});
+	std::tuple<board_t, std::vector<int>> search(board_t initialBoard, const std::string& target, const Options& options = {});
+	solver::Solution searchWithin(board_t initialBoard, const std::string& target, const solver::Budget& budget, const Options& options = {});
+}
@@ -0,0 +1,124 @@
+//
+// FILENAME: frontier.hpp | Shifting Stones Search
+// DESCRIPTION: A compressed container for sorted sets of boards
+// CREATED: 2026-10-18 @ 1:26 PM
+//
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "decl.h"
+
+namespace frontier {
+	/**
+	 * @brief The number of boards encoded together in a block
+	 */
+	const std::size_t BLOCK_SIZE = 128;
+
+	/**
+	 * @brief The number of interleaved lanes the deltas of a block are packed into
+	 *
+	 * @note  Each lane holds every `BLOCK_LANES`-th delta, so all lanes are unpacked with the same shifts and the
+	 * 		  decode loop maps directly onto 128-bit vector registers
+	 */
+	const std::size_t BLOCK_LANES = 4;
+
+	/**
+	 * @brief The number of header words stored before the packed deltas of a block
+	 */
+	const std::size_t BLOCK_HEADER = 2;
+
+	std::size_t encodeBlock(const board_t* boards, std::size_t count, std::vector<uint32_t>& out);
+	std::size_t decodeBlock(const uint32_t* in, board_t* boards);
+	std::size_t blockWords(uint32_t header);
+
+	/**
+	 * @brief A sorted, duplicate-free set of boards stored as bit-packed frame-of-reference blocks
+	 *
+	 * @note  Each block stores its first board and the bit width of its largest delta, followed by every
+	 * 		  delta packed at that width. Dense BFS levels need about 1.7 bytes per board, against 4 unencoded.
+	 */
+	class CompressedFrontier {
+	public:
+		/**
+		 * @brief Sequentially read the boards of a `CompressedFrontier`
+		 */
+		class Cursor {
+		public:
+			explicit Cursor(const CompressedFrontier& frontier);
+
+			bool next(board_t& board);
+			bool contains(board_t board);
+
+		private:
+			const CompressedFrontier& frontier;
+			board_t 				  block[BLOCK_SIZE];
+			std::size_t 			  word = 0;
+			std::size_t 			  position = 0;
+			std::size_t 			  length = 0;
+			board_t 				  head = 0;
+			bool 					  valid = false;
+			bool 					  started = false;
+		};
+
+		CompressedFrontier() = default;
+
+		void push(board_t board);
+		void finish();
+		void clear();
+
+		bool write(FILE* file) const;
+		bool read(FILE* file);
+
+		/**
+		 * @brief Get the number of boards stored in the frontier
+		 */
+		inline std::size_t size() const {
+			return count;
+		}
+
+		/**
+		 * @brief Check if the frontier holds no boards
+		 */
+		inline bool empty() const {
+			return count == 0;
+		}
+
+		/**
+		 * @brief Get the number of bytes used by the encoded blocks
+		 */
+		inline std::size_t bytes() const {
+			return words.size() * sizeof(uint32_t);
+		}
+
+		/**
+		 * @brief Call a function on every board, in ascending order
+		 *
+		 * @param 	visit 	The function to call
+		 */
+		template<class Visitor>
+		void forEach(Visitor&& visit) const {
+			board_t block[BLOCK_SIZE];
+
+			for (std::size_t i = 0; i < words.size(); i += blockWords(words[i])) {
+				std::size_t decoded = decodeBlock(&words[i], block);
+
+				for (std::size_t j = 0; j < decoded; j++) {
+					visit(block[j]);
+				}
+			}
+
+			for (board_t board: pending) {
+				visit(board);
+			}
+		}
+
+	private:
+		std::vector<uint32_t> words; 	// The encoded blocks
+		std::vector<board_t>  pending; 	// Boards waiting for a full block
+		std::size_t 		  count = 0;
+	};
+}
@@ -0,0 +1,90 @@
+//
+// FILENAME: game.hpp | Shifting Stones Search
+// DESCRIPTION: Two-player game-tree search with alpha-beta pruning
+// CREATED: 2026-10-24 @ 11:30 AM
+//
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "decl.h"
+#include "neighbors.hpp"
+#include "solver.hpp"
+#include "transposition.hpp"
+
+namespace game {
+	/**
+	 * @brief The score of completing a card immediately. Completing one `n` moves from now scores `WIN - n`.
+	 */
+	const int WIN = 100;
+
+	/**
+	 * @brief The deepest a search can look, in moves by either player
+	 */
+	const int MAX_PLY = transposition::MAX_DEPTH;
+
+	/**
+	 * @brief The size of the transposition table an engine allocates when it isn't given a shared one
+	 */
+	const std::size_t DEFAULT_TABLE_MB = 16;
+
+	/**
+	 * @brief The cards each player is trying to complete, indexed by player (0 or 1)
+	 */
+	using Hands = std::array<std::vector<std::string>, 2>;
+
+	/**
+	 * @struct Result
+	 * @brief The outcome of a game-tree search
+	 */
+	struct Result {
+		solver::Status 	 status = solver::Status::Unsolvable;
+		int 			 move = 0; 	// The best move (1 - 21) for the player to move, or 0 if there is none
+		int 			 score = 0; // The score of `move` for the player to move. Positive scores favour them.
+		int 			 depth = 0; // The deepest iteration completed
+		std::vector<int> pv; 		// The expected moves of both players, starting with `move`
+		std::size_t 	 nodes = 0; // The number of positions searched
+	};
+
+	/**
+	 * @brief Searches positions where two players take turns moving the same board
+	 *
+	 * @note  Each turn is a single move. A player completes a card when the board matches it at the end of their
+	 * 		  move, or at the start of their turn, and the game ends there. Positions are scored by how many moves each
+	 * 		  player is from their nearest card, which is exact for a player moving alone. The opponent's moves are
+	 * 		  what the search adds.
+	 */
+	class Engine {
+	public:
+		Engine(const neighbors::NeighborTable& table, const Hands& hands, transposition::TranspositionTable* transpositions = nullptr);
+
+		void setHand(int player, const std::vector<std::string>& hand);
+		int evaluate(board_t board, int player) const;
+		Result search(board_t board, int player, const solver::Budget& budget = {});
+
+	private:
+		const neighbors::NeighborTable& 	table;
+		std::unique_ptr<transposition::TranspositionTable> owned; 	// The table used when no shared one is given
+		transposition::TranspositionTable* 	transpositions;
+		std::array<std::vector<uint8_t>, 2> distance; 	// Each player's distance to their nearest card from every state
+
+		// The state of the search in progress
+		solver::Budget 						budget;
+		std::size_t 						nodes = 0;
+		bool 								stopped = false;
+		solver::Status 						stopReason = solver::Status::Solved;
+		bool 								followingPV = false; 	// Whether every move so far follows `previousPV`
+		std::array<std::array<int, MAX_PLY + 1>, MAX_PLY + 1> pv = {}; 	// The best line found from each ply
+		std::array<int, MAX_PLY + 1> 		pvLength = {};
+		std::vector<int> 					previousPV; 	// The best line of the last completed iteration
+
+		int heuristic(uint32_t state, int player) const;
+		int negamax(uint32_t state, int player, int depth, int ply, int alpha, int beta);
+		bool outOfBudget();
+	};
+}
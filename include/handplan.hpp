@@ -0,0 +1,47 @@
+//
+// FILENAME: handplan.hpp | Shifting Stones Search
+// DESCRIPTION: Plan the cheapest order to complete a hand of cards
+// CREATED: 2026-10-24 @ 9:20 AM
+//
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "decl.h"
+#include "neighbors.hpp"
+#include "solver.hpp"
+#include "weighted.hpp"
+
+namespace handplan {
+	/**
+	 * @brief The largest hand a plan can be made for
+	 *
+	 * @note  The planner runs one search per subset of the hand, so the work doubles with each card
+	 */
+	const int MAX_HAND_SIZE = 6;
+
+	/**
+	 * @struct Step
+	 * @brief Completing one card of the hand
+	 */
+	struct Step {
+		std::string 	 card; 		// The ID of the card completed
+		std::vector<int> moves; 	// The moves from the board the previous step left behind
+		board_t 		 board = 0; // The board that completes the card, and that the next step starts from
+		int 			 cost = 0; 	// The total cost of `moves`
+	};
+
+	/**
+	 * @struct Plan
+	 * @brief The cheapest order to complete a hand of cards
+	 */
+	struct Plan {
+		solver::Status 	  status = solver::Status::Unsolvable;
+		std::vector<Step> steps; 	// One step per card, in the order they are completed
+		int 			  cost = 0; // The total cost of every step
+	};
+
+	Plan plan(const neighbors::NeighborTable& table, board_t board, const std::vector<std::string>& hand, const weighted::MoveCosts& costs = weighted::makeCosts(), const solver::Budget& budget = {});
+}
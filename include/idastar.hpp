@@ -0,0 +1,22 @@
+//
+// FILENAME: idastar.hpp | Shifting Stones Search
+// DESCRIPTION: Iterative deepening A* search backed by a shared transposition table
+// CREATED: 2026-10-21 @ 4:05 PM
+//
+
+#pragma once
+
+#include <string>
+
+#include "decl.h"
+#include "solver.hpp"
+#include "transposition.hpp"
+
+namespace idastar {
+	/**
+	 * @brief The largest threshold tried before a board is reported as unsolvable
+	 */
+	const int MAX_THRESHOLD = transposition::MAX_DEPTH;
+
+	solver::Solution solve(board_t board, const std::string& target, const solver::Budget& budget = {}, transposition::TranspositionTable* transpositions = nullptr, int lowerBound = 0);
+}
@@ -0,0 +1,60 @@
+//
+// FILENAME: incremental.hpp | Shifting Stones Search
+// DESCRIPTION: Re-solve a query cheaply after the board changes by one move
+// CREATED: 2026-10-22 @ 1:50 PM
+//
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "decl.h"
+#include "solver.hpp"
+#include "transposition.hpp"
+
+namespace incremental {
+	/**
+	 * @brief The size of the transposition table a solver allocates when it isn't given a shared one
+	 */
+	const std::size_t DEFAULT_TABLE_MB = 16;
+
+	/**
+	 * @brief How the latest solution was found
+	 */
+	enum class Reuse {
+		Cold, 		// A full search from the new board
+		Shifted, 	// The move was the first move of the previous solution, or the board can't be solved either way
+		Bounded 	// A search bounded by the previous solution's length
+	};
+
+	/**
+	 * @brief Follows one game toward a target card, keeping the solution current as moves are made
+	 *
+	 * @note  A single move changes the distance to the goal by at most one. If the previous solution took `D` moves,
+	 * 		  undoing the move and following it is a solution of `D + 1` moves, so the new search only has to look
+	 * 		  between `D - 1` and `D` moves. Bounds from earlier searches stay in the transposition table. A solution
+	 * 		  kept after the budget ran out is followed the same way, between its lower bound less one and its length.
+	 */
+	class IncrementalSolver {
+	public:
+		IncrementalSolver(const std::string& target, transposition::TranspositionTable* transpositions = nullptr);
+
+		const solver::Solution& reset(board_t board, const solver::Budget& budget = {});
+		const solver::Solution& apply(int move, const solver::Budget& budget = {});
+
+		board_t board() const { return current; }
+		const solver::Solution& solution() const { return latest; }
+		Reuse lastReuse() const { return reuse; }
+
+	private:
+		std::string 									 target;
+		std::unique_ptr<transposition::TranspositionTable> owned; 	// The table used when no shared one is given
+		transposition::TranspositionTable* 				 transpositions;
+
+		board_t 		 current = 0;
+		solver::Solution latest;
+		bool 			 hasSolution = false; 	// Whether `latest` was found for a board this solver has followed
+		Reuse 			 reuse = Reuse::Cold;
+	};
+}
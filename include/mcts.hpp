@@ -0,0 +1,136 @@
+//
+// FILENAME: mcts.hpp | Shifting Stones Search
+// DESCRIPTION: Parallel Monte Carlo tree search for two-player play with hidden hands
+// CREATED: 2026-10-24 @ 2:40 PM
+//
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "decl.h"
+#include "solver.hpp"
+#include "successstates.hpp"
+
+namespace mcts {
+	/**
+	 * @brief The first-child value of a node whose children are being added, or can't be added because the pool is
+	 * 		  full. Such nodes are treated as leaves.
+	 */
+	const uint32_t EXPANDING = UINT32_MAX;
+
+	/**
+	 * @struct Options
+	 * @brief Settings for a search
+	 */
+	struct Options {
+		unsigned 	threads = 0; 				// The number of search threads, or 0 for one per hardware thread
+		std::size_t simulations = 10000; 		// The number of playouts per search
+		std::size_t maxNodes = 1 << 20; 		// The size of the node pool (~24 bytes per node)
+		double 		exploration = 1.4; 			// The UCT exploration constant
+		int 		virtualLoss = 3; 			// The losses a thread adds to each node it passes, until its playout ends
+		int 		playoutDepth = 40; 			// The longest playout before it is scored by distance estimates
+		uint64_t 	seed = 0; 					// The seed of the thread random generators, or 0 to seed randomly
+	};
+
+	/**
+	 * @struct Deal
+	 * @brief What the searching player knows about the cards in play
+	 *
+	 * @note  Each playout draws `hiddenCards` cards from `unseen` to complete the opponent's hand, so the search
+	 * 		  averages over the hands the opponent could hold
+	 */
+	struct Deal {
+		std::vector<std::string> own; 				// The searching player's cards
+		std::vector<std::string> opponent; 			// The opponent's known cards
+		std::vector<std::string> unseen; 			// The cards the opponent's hidden cards could be
+		int 					 hiddenCards = 0; 	// The number of cards in the opponent's hand that aren't known
+	};
+
+	/**
+	 * @struct Result
+	 * @brief The outcome of a search
+	 */
+	struct Result {
+		solver::Status 							 status = solver::Status::Unsolvable;
+		int 									 move = 0; 			// The most visited move (1 - 21), or 0 if there is none
+		double 									 winRate = 0; 		// The searching player's average result after `move`
+		std::array<uint32_t, POSSIBLE_CONFIGS> 	 visits = {}; 		// The playouts through each move
+		std::size_t 							 simulations = 0; 	// The playouts run
+		std::size_t 							 nodes = 0; 		// The nodes in the tree
+	};
+
+	namespace __detail {
+		/**
+		 * @struct __node
+		 * @brief A tree node. Every field read by more than one thread is atomic.
+		 *
+		 * @note  `value` counts half points for the player who made the move into the node: 2 per win, 1 per draw
+		 */
+		struct __node {
+			board_t 			  board = 0;
+			uint8_t 			  move = 0; 		// The move that led to the node
+			uint8_t 			  childCount = 0;
+			std::atomic<uint32_t> firstChild = 0; 	// The pool index of the first child, 0 before expansion, or `EXPANDING`
+			std::atomic<uint32_t> visits = 0;
+			std::atomic<uint32_t> value = 0;
+		};
+
+		/**
+		 * @brief A fixed block of nodes handed out by an atomic bump pointer
+		 *
+		 * @note  Threads claim whole runs of children with one `fetch_add`, so allocation never locks. Nodes are only
+		 * 		  freed all at once between searches.
+		 */
+		class __node_pool {
+		public:
+			explicit __node_pool(std::size_t capacity);
+
+			uint32_t allocate(uint32_t count);
+			void reset();
+
+			__node& operator[](uint32_t index) { return nodes[index]; }
+			std::size_t size() const;
+
+		private:
+			std::unique_ptr<__node[]> nodes;
+			std::size_t 			  capacity;
+			std::atomic<std::size_t>  next = 0;
+		};
+	}
+
+	/**
+	 * @brief Picks moves by running random playouts from a shared tree on every core
+	 *
+	 * @note  Turns follow the same rules as `game::Engine`: players alternate single moves, and a player completes a
+	 * 		  card when the board matches it at the end of their move or the start of their turn. Threads share one
+	 * 		  tree and add a virtual loss to each node they pass, which steers the other threads down different lines.
+	 * 		  Playouts take any move that completes the mover's card and otherwise move at random.
+	 */
+	class Engine {
+	public:
+		Engine(const Deal& deal, const Options& options = {});
+
+		Result search(board_t board, const solver::Budget& budget = {});
+
+	private:
+		using masks_type = std::vector<success_states::GoalMask>;
+
+		Options 				options;
+		masks_type 				own; 		// The masks of the searching player's cards
+		masks_type 				opponent; 	// The masks of the opponent's known cards
+		std::vector<masks_type> unseen; 	// The masks of each card the opponent could hold
+		int 					hiddenCards;
+		__detail::__node_pool 	pool;
+
+		uint32_t select(uint32_t node);
+		bool expand(uint32_t node);
+		int playout(board_t board, int player, const std::array<const masks_type*, 2>& goals, std::mt19937_64& random) const;
+	};
+}
@@ -0,0 +1,39 @@
+//
+// FILENAME: msbfs.hpp | Shifting Stones Search
+// DESCRIPTION: Multi-source bit-parallel breadth-first search for distance statistics
+// CREATED: 2026-10-19 @ 3:30 PM
+//
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "decl.h"
+#include "neighbors.hpp"
+
+namespace msbfs {
+	/**
+	 * @brief The number of sources searched together, one per bit of a lane
+	 */
+	const std::size_t BATCH_SIZE = 64;
+
+	/**
+	 * @struct Statistics
+	 * @brief Distance statistics gathered from a set of sources
+	 */
+	struct Statistics {
+		std::vector<uint32_t> sources; 		 // The state index of each source
+		std::vector<uint8_t>  eccentricity;  // The largest distance from each source to any reachable state
+		std::vector<uint64_t> histogram; 	 // The number of (source, state) pairs at each distance
+		int 				  diameter = 0;  // The largest eccentricity
+		int 				  radius = 0; 	 // The smallest eccentricity
+
+		void merge(const Statistics& other);
+		double meanDistance() const;
+	};
+
+	Statistics batch(const neighbors::NeighborTable& table, const uint32_t* sources, std::size_t count);
+	Statistics fromSources(const neighbors::NeighborTable& table, const std::vector<uint32_t>& sources, unsigned threads = 0);
+	Statistics allStates(const neighbors::NeighborTable& table, unsigned threads = 0);
+}
@@ -0,0 +1,92 @@
+//
+// FILENAME: neighbors.hpp | Shifting Stones Search
+// DESCRIPTION: A precomputed table of neighboring board states
+// CREATED: 2026-10-19 @ 8:40 AM
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "decl.h"
+
+namespace neighbors {
+	/**
+	 * @brief The default file the neighbor table is stored in
+	 */
+	const char* const NEIGHBOR_FILE = "neighbors.bin";
+
+	/**
+	 * @brief Marks an unreached state in a distance table
+	 */
+	const uint8_t UNREACHED = 0xFF;
+
+	uint32_t computeNeighbor(uint32_t index, int move);
+
+	/**
+	 * @brief A `MAX_BOARD_STATES` x `POSSIBLE_CONFIGS` table mapping a state index and a move to the index of the
+	 * 		  resulting state
+	 *
+	 * @note  State indices are positions in `BOARD_STATES`. Moves are numbered 1 - 21, as in `__permuteBoard`.
+	 */
+	class NeighborTable {
+	public:
+		NeighborTable() = default;
+		~NeighborTable();
+
+		NeighborTable(const NeighborTable&) = delete;
+		NeighborTable& operator=(const NeighborTable&) = delete;
+
+		void build();
+		bool load(const std::string& path = NEIGHBOR_FILE);
+		bool save(const std::string& path = NEIGHBOR_FILE) const;
+		bool saveIfMissing(const std::string& path = NEIGHBOR_FILE) const;
+		void release();
+
+		/**
+		 * @brief Check if the table holds any data
+		 */
+		inline bool loaded() const {
+			return data != nullptr;
+		}
+
+		/**
+		 * @brief Check if the table is mapped from a file rather than built in memory
+		 */
+		inline bool mapped() const {
+			return mapping != nullptr;
+		}
+
+		/**
+		 * @brief Get the index of the state reached by applying a move
+		 *
+		 * @param 	index 	The index of the starting state
+		 * @param 	move 	The move to apply (1 - 21)
+		 * @return 			The index of the resulting state
+		 */
+		inline uint32_t neighbor(uint32_t index, int move) const {
+			return data[POSSIBLE_CONFIGS * index + move - 1];
+		}
+
+		/**
+		 * @brief Get every neighbor of a state
+		 *
+		 * @param 	index 	The index of the state
+		 * @return 			A pointer to the `POSSIBLE_CONFIGS` neighbor indices, in move order
+		 */
+		inline const uint32_t* row(uint32_t index) const {
+			return data + POSSIBLE_CONFIGS * index;
+		}
+
+	private:
+		const uint32_t* 	  data = nullptr; 	// The table, either owned or mapped from a file
+		std::vector<uint32_t> owned; 			// Storage for a table built in memory
+		void* 				  mapping = nullptr; // The start of the mapped file, if any
+		std::size_t 		  mappedBytes = 0;
+	};
+
+	const NeighborTable* sharedTable(const std::string& path = NEIGHBOR_FILE);
+	std::vector<uint8_t> distances(const NeighborTable& table, const std::vector<uint32_t>& sources);
+}
@@ -0,0 +1,93 @@
+//
+// FILENAME: policy.hpp | Shifting Stones Search
+// DESCRIPTION: Precomputed optimal moves from every state toward a target card
+// CREATED: 2026-10-20 @ 11:45 AM
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "decl.h"
+#include "neighbors.hpp"
+
+namespace policy {
+	/**
+	 * @brief The bits of a policy entry holding the mask of optimal moves
+	 *
+	 * @note  Bit `i` is set when move `i + 1` is optimal
+	 */
+	const uint32_t MOVE_MASK = (1U << POSSIBLE_CONFIGS) - 1;
+
+	/**
+	 * @brief The position of the distance to the nearest success state in a policy entry
+	 */
+	const int DISTANCE_SHIFT = 24;
+
+	/**
+	 * @brief The distance stored for states that can't reach a success state
+	 */
+	const uint8_t UNSOLVABLE = 0xFF;
+
+	/**
+	 * @brief The best moves from every state toward the success states of one target card
+	 *
+	 * @note  Each state stores a 32-bit entry: the mask of every optimal move in the low 21 bits and the distance to
+	 * 		  the nearest success state in the high 8 bits. A table takes ~10 MB.
+	 */
+	class PolicyTable {
+	public:
+		PolicyTable() = default;
+
+		void build(const neighbors::NeighborTable& table, const std::string& target, unsigned threads = 0);
+		bool load(const std::string& path);
+		bool save(const std::string& path) const;
+
+		/**
+		 * @brief Get the number of moves from a state to the nearest success state
+		 *
+		 * @param 	index 	The `BOARD_STATES` index of the state
+		 * @return 			The distance, or `UNSOLVABLE`
+		 */
+		inline uint8_t distance(uint32_t index) const {
+			return entries[index] >> DISTANCE_SHIFT;
+		}
+
+		/**
+		 * @brief Get every optimal move from a state
+		 *
+		 * @param 	index 	The `BOARD_STATES` index of the state
+		 * @return 			A mask with bit `i` set when move `i + 1` is optimal, or 0 at a success state
+		 */
+		inline uint32_t optimalMoves(uint32_t index) const {
+			return entries[index] & MOVE_MASK;
+		}
+
+		/**
+		 * @brief Get the card the table was built for
+		 */
+		inline const std::string& target() const {
+			return card;
+		}
+
+		/**
+		 * @brief Check if the table holds any data
+		 */
+		inline bool built() const {
+			return !entries.empty();
+		}
+
+		int bestMove(uint32_t index) const;
+		std::vector<int> optimalMoveList(board_t board) const;
+		std::vector<int> solve(board_t board, const neighbors::NeighborTable* table = nullptr) const;
+
+	private:
+		std::vector<uint32_t> entries;
+		std::string 		  card;
+	};
+
+	std::string policyPath(const std::string& directory, const std::string& target);
+	std::size_t buildAll(const neighbors::NeighborTable& table, const std::string& directory, unsigned threads = 0);
+}
@@ -0,0 +1,75 @@
+//
+// FILENAME: reachability.hpp | Shifting Stones Search
+// DESCRIPTION: Connected components of the state graph
+// CREATED: 2026-10-20 @ 9:20 AM
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "decl.h"
+#include "neighbors.hpp"
+
+namespace reachability {
+	/**
+	 * @brief The default file the component index is stored in
+	 */
+	const char* const COMPONENT_FILE = "components.bin";
+
+	/**
+	 * @brief A labeling of the state graph's connected components, with the components holding a success state for
+	 * 		  each target card
+	 *
+	 * @note  Every move is its own inverse, so two boards can reach each other exactly when they share a component.
+	 * 		  The graph is connected, so `componentCount` is 1 and `solvable` only rejects boards that aren't valid
+	 * 		  states. The index verifies that rather than filtering queries; `policy::PolicyTable::distance` gives
+	 * 		  the bound a search can actually prune with.
+	 */
+	class ComponentIndex {
+	public:
+		ComponentIndex() = default;
+
+		void build(const neighbors::NeighborTable& table, unsigned threads = 0);
+		bool load(const std::string& path = COMPONENT_FILE);
+		bool save(const std::string& path = COMPONENT_FILE) const;
+
+		bool solvable(board_t board, const std::string& target) const;
+		bool solvable(uint32_t index, int card) const;
+		bool connected(board_t first, board_t second) const;
+
+		/**
+		 * @brief Get the component of a state
+		 *
+		 * @param 	index 	The `BOARD_STATES` index of the state
+		 * @return 			The component label (0 - `componentCount() - 1`)
+		 */
+		inline uint32_t component(uint32_t index) const {
+			return labels[index];
+		}
+
+		/**
+		 * @brief Get the number of connected components
+		 */
+		inline uint32_t componentCount() const {
+			return components;
+		}
+
+		/**
+		 * @brief Check if the index holds any data
+		 */
+		inline bool built() const {
+			return !labels.empty();
+		}
+
+	private:
+		std::vector<uint32_t> labels; 		// The component of each `BOARD_STATES` index
+		std::vector<uint64_t> goalFlags; 	// One bit per component for each card, `flagWords` words per card
+		uint32_t 			  components = 0;
+		uint32_t 			  flagWords = 0;
+
+		void flagGoals();
+	};
+}
@@ -0,0 +1,76 @@
+//
+// FILENAME: simulator.hpp | Shifting Stones Search
+// DESCRIPTION: Play many complete games in parallel and gather statistics on them
+// CREATED: 2026-10-24 @ 5:15 PM
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "decl.h"
+#include "neighbors.hpp"
+#include "solver.hpp"
+
+namespace simulator {
+	/**
+	 * @brief The most players a game can have
+	 */
+	const int MAX_PLAYERS = 4;
+
+	/**
+	 * @brief How a player picks their moves
+	 */
+	enum class Policy {
+		Random, // Any move that changes the board
+		Greedy, // The move with the best distance estimate to any card in hand
+		Exact 	// The move with the fewest remaining moves to any card in hand. Needs a neighbor table.
+	};
+
+	/**
+	 * @struct Options
+	 * @brief The games to play
+	 */
+	struct Options {
+		std::size_t 			 games = 100000;
+		unsigned 				 threads = 0; 		// The number of threads, or 0 for one per hardware thread
+		std::vector<Policy> 	 policies = {Policy::Greedy, Policy::Greedy}; // One policy per player
+		std::vector<std::string> deck; 				// The cards dealt from, or every card if empty
+		int 					 handSize = 3; 		// The cards each player holds
+		int 					 movesPerTurn = 1; 	// The moves a player makes each turn
+		int 					 cardsToWin = 3; 	// The cards a player completes to win
+		int 					 maxTurns = 200; 	// The turns after which a game is stopped unfinished
+		uint64_t 				 seed = 0; 			// The seed of the thread random generators, or 0 to seed randomly
+		const neighbors::NeighborTable* table = nullptr; // Required by `Policy::Exact`
+	};
+
+	/**
+	 * @struct CardStats
+	 * @brief How one card fared across every game
+	 */
+	struct CardStats {
+		uint64_t dealt = 0; 	// The times the card was drawn into a hand
+		uint64_t completed = 0; // The times the card was completed
+		uint64_t turnsHeld = 0; // The turns completed cards were held before being completed
+	};
+
+	/**
+	 * @struct Stats
+	 * @brief Totals across every game played
+	 */
+	struct Stats {
+		solver::Status 		   status = solver::Status::Unsolvable;
+		uint64_t 			   games = 0;
+		uint64_t 			   turns = 0;
+		uint64_t 			   unfinished = 0; 	// Games stopped after `maxTurns`
+		std::vector<uint64_t>  lengths; 		// The number of games that lasted each number of turns
+		std::vector<uint64_t>  wins; 			// The games won by each player
+		std::vector<CardStats> cards; 			// Indexed by `success_states::cardIndex`
+
+		void merge(const Stats& other);
+	};
+
+	Stats run(const Options& options, const solver::Budget& budget = {});
+}
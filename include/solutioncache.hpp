@@ -0,0 +1,101 @@
+//
+// FILENAME: solutioncache.hpp | Shifting Stones Search
+// DESCRIPTION: A bounded cache of search results shared across queries
+// CREATED: 2026-10-22 @ 9:30 AM
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "decl.h"
+#include "neighbors.hpp"
+#include "solver.hpp"
+
+namespace solutioncache {
+	/**
+	 * @brief The approximate number of bytes a cached result costs, including its share of the index
+	 */
+	const std::size_t ENTRY_BYTES = 64;
+
+	/**
+	 * @struct Options
+	 * @brief Settings for a solution cache
+	 */
+	struct Options {
+		std::size_t maxBytes = 16UL << 20; 	// The memory the cache may use
+		std::string path = ""; 				// A file to load the cache from and save it to on destruction, if any
+	};
+
+	/**
+	 * @struct Stats
+	 * @brief Counters describing how well the cache is doing
+	 */
+	struct Stats {
+		std::size_t hits;
+		std::size_t misses;
+		std::size_t evictions;
+		std::size_t entries;
+		std::size_t capacity;
+	};
+
+	/**
+	 * @brief Remembers the results of (board, card, depth limit) queries as compact move lists
+	 *
+	 * @note  Lookups only take a shared lock, so any number of threads can read at once. Entries are evicted with
+	 * 		  the CLOCK policy: a lookup sets an entry's reference bit, and the eviction hand clears bits until it finds
+	 * 		  an entry that hasn't been used since its last pass.
+	 */
+	class SolutionCache {
+	public:
+		explicit SolutionCache(const Options& options = {});
+		~SolutionCache();
+
+		SolutionCache(const SolutionCache&) = delete;
+		SolutionCache& operator=(const SolutionCache&) = delete;
+
+		bool lookup(board_t board, const std::string& target, int maxDepth, solver::Solution& solution);
+		void insert(board_t board, const std::string& target, int maxDepth, const solver::Solution& solution);
+		solver::Solution solve(board_t board, const std::string& target, const solver::Budget& budget = {}, const neighbors::NeighborTable* table = nullptr);
+
+		bool load(const std::string& path);
+		bool save(const std::string& path) const;
+		void clear();
+
+		Stats stats() const;
+
+	private:
+		/**
+		 * @struct __cache_entry
+		 * @brief A stored result
+		 */
+		struct __cache_entry {
+			uint64_t key; 			// The packed (board, card, depth limit)
+			uint64_t moves; 		// The move list, packed by `batch::encodeMoves`
+			uint8_t  count; 		// The number of moves
+			uint8_t  status; 		// The `solver::Status` of the result
+			uint8_t  optimal;
+			uint8_t  lowerBound;
+		};
+
+		Options 							 options;
+		std::vector<__cache_entry> 			 entries;
+		std::unique_ptr<std::atomic<bool>[]> referenced; 	// The CLOCK reference bit of each entry
+		std::unordered_map<uint64_t, std::size_t> index; 	// Maps each key to its entry
+		std::size_t 						 capacity;
+		std::size_t 						 hand = 0; 		// The next entry the CLOCK hand looks at
+		mutable std::shared_mutex 			 lock;
+
+		std::atomic<std::size_t> hits = 0;
+		std::atomic<std::size_t> misses = 0;
+		std::atomic<std::size_t> evictions = 0;
+
+		void store(const __cache_entry& entry);
+	};
+}
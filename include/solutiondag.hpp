@@ -0,0 +1,54 @@
+//
+// FILENAME: solutiondag.hpp | Shifting Stones Search
+// DESCRIPTION: Every optimal solution to a query, stored as a layered graph
+// CREATED: 2026-10-23 @ 5:10 PM
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "decl.h"
+#include "neighbors.hpp"
+#include "policy.hpp"
+#include "solver.hpp"
+
+namespace solutiondag {
+	/**
+	 * @struct Level
+	 * @brief The states a fixed number of moves into some optimal solution
+	 */
+	struct Level {
+		std::vector<uint32_t> states; 	// `BOARD_STATES` indices in ascending order
+		std::vector<uint32_t> moves; 	// For each state, a mask with bit `i` set when move `i + 1` leads to the next level
+	};
+
+	/**
+	 * @struct SolutionDAG
+	 * @brief Every shortest path from a board to a target card
+	 *
+	 * @note  Level 0 holds the starting board and the last level holds the success states reached. Every state in
+	 * 		  the graph lies on at least one optimal solution, and the solutions are exactly the paths that follow a
+	 * 		  set bit from level 0 to the last level. Paths are never written out, since their number can grow
+	 * 		  exponentially with the depth.
+	 */
+	struct SolutionDAG {
+		solver::Status 	   status = solver::Status::Unsolvable;
+		std::vector<Level> levels;
+
+		/**
+		 * @brief Get the length of every solution, or -1 if there are none
+		 */
+		inline int depth() const {
+			return (int)levels.size() - 1;
+		}
+	};
+
+	SolutionDAG enumerate(board_t board, const std::string& target, const solver::Budget& budget = {}, const neighbors::NeighborTable* table = nullptr);
+	SolutionDAG enumerate(const neighbors::NeighborTable& table, const policy::PolicyTable& policy, board_t board);
+
+	int find(const Level& level, uint32_t state);
+	uint64_t countPaths(const SolutionDAG& dag, const neighbors::NeighborTable* table = nullptr);
+}
@@ -0,0 +1,61 @@
+//
+// FILENAME: solver.hpp | Shifting Stones Search
+// DESCRIPTION: Interruptible breadth-first search for a single (board, card) query
+// CREATED: 2026-10-21 @ 9:05 AM
+//
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <stop_token>
+#include <string>
+#include <vector>
+
+#include "decl.h"
+#include "neighbors.hpp"
+
+namespace solver {
+	using clock_type = std::chrono::steady_clock;
+
+	/**
+	 * @brief The outcome of a search
+	 */
+	enum class Status {
+		Solved, 	// An optimal solution was found
+		Unsolvable, // No success state can be reached
+		Cancelled, 	// The search was stopped through its stop token
+		TimedOut, 	// The deadline passed before the search finished
+		Exhausted, 	// The node, memory or depth limit was reached before the search finished
+		IOError 	// The search couldn't read or write its working files
+	};
+
+	/**
+	 * @struct Budget
+	 * @brief Limits on how much a search may do
+	 */
+	struct Budget {
+		std::stop_token 		stop = {}; 							// Requests the search to stop early
+		clock_type::time_point 	deadline = clock_type::time_point::max(); // The time the search must give up by
+		std::size_t 			maxNodes = 0; 						// The most states to expand, or 0 for no limit
+		std::size_t 			maxMemory = 0; 						// The most bytes of search state, or 0 for no limit
+		int 					maxDepth = -1; 						// The longest solution to look for, or -1 for no limit
+	};
+
+	/**
+	 * @struct Solution
+	 * @brief The result of a search
+	 *
+	 * @note  A search that runs out of budget reports the board it reached that looked closest to the goal, with the
+	 * 		  moves leading to it. The lower bound is proven even then.
+	 */
+	struct Solution {
+		Status 			 status = Status::Unsolvable;
+		board_t 		 board = 0; 		// The success state reached, the best partial board, or 0 if neither
+		std::vector<int> moves; 			// The moves leading to `board`, in the order they are applied
+		bool 			 optimal = false; 	// Whether `board` is a success state and `moves` is proven shortest
+		int 			 lowerBound = 0; 	// A proven lower bound on the optimal number of moves
+	};
+
+	Solution solve(board_t board, const std::string& target, const Budget& budget = {}, const neighbors::NeighborTable* table = nullptr);
+}
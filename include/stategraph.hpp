@@ -0,0 +1,43 @@
+//
+// FILENAME: stategraph.hpp | Shifting Stones Search
+// DESCRIPTION: The full state graph as a Boost compressed sparse row graph
+// CREATED: 2026-10-23 @ 1:25 PM
+//
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <boost/graph/compressed_sparse_row_graph.hpp>
+
+#include "decl.h"
+#include "neighbors.hpp"
+
+namespace stategraph {
+	namespace __detail {
+		/**
+		 * @struct __edge_property
+		 * @brief A custom edge value for the state graph
+		 */
+		struct __edge_property {
+			uint8_t move; // The move (1 - 21) the edge stands for
+		};
+	}
+
+	/**
+	 * @brief The state graph. Vertex numbers are `BOARD_STATES` indices.
+	 *
+	 * @note  Compressed sparse row graphs are directed, but every move is its own inverse, so each edge appears in
+	 * 		  both directions and the graph can be treated as undirected
+	 */
+	using graph_t = boost::compressed_sparse_row_graph<
+		boost::directedS, boost::no_property, __detail::__edge_property, boost::no_property, uint32_t, uint32_t
+	>;
+
+	using vertex_t = boost::graph_traits<graph_t>::vertex_descriptor;
+	using edge_t = boost::graph_traits<graph_t>::edge_descriptor;
+
+	graph_t build(const neighbors::NeighborTable* table = nullptr);
+	std::vector<uint8_t> distances(const graph_t& graph, vertex_t source);
+}
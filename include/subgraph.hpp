@@ -0,0 +1,35 @@
+//
+// FILENAME: subgraph.hpp | Shifting Stones Search
+// DESCRIPTION: Extract small, deduplicated pieces of the state graph for visualization
+// CREATED: 2026-10-23 @ 10:15 AM
+//
+
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "decl.h"
+#include "neighbors.hpp"
+#include "policy.hpp"
+
+namespace subgraph {
+	using edge_t = std::pair<uint32_t, uint32_t>;
+
+	/**
+	 * @struct Subgraph
+	 * @brief A set of distinct boards and the moves between them
+	 *
+	 * @note  Vertices are numbered from 0 in the order they were reached, so vertex 0 is always the starting board
+	 */
+	struct Subgraph {
+		std::vector<board_t> boards; 			// The board of each vertex
+		std::vector<edge_t>  edges; 			// Pairs of vertex numbers
+		std::vector<int> 	 moves; 			// The move (1 - 21) each edge stands for
+		bool 				 directed = false; 	// Whether edges only lead from the first vertex to the second
+	};
+
+	Subgraph ball(const neighbors::NeighborTable& table, board_t center, int hops);
+	Subgraph optimalDAG(const neighbors::NeighborTable& table, const policy::PolicyTable& policy, board_t board);
+}
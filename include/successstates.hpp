@@ -17,6 +17,7 @@ namespace success_states {
 
 	const static std::string& getID(board_t board) {
 		static std::string id = "";
+		id.clear();
 		id.reserve(9);
 
 		for (int i = 24; i >= 0; i -= 3) {
@@ -26,8 +27,36 @@ namespace success_states {
 		return id;
 	}
 	
+	/**
+	 * @struct GoalMask
+	 * @brief A success state reduced to bit masks. A board matches when `(board & mask) == value`.
+	 */
+	struct GoalMask {
+		board_t mask = 0; 	// Set on the 3 bits of every tile that isn't a placeholder
+		board_t value = 0; 	// The tiles the success state requires, with placeholders cleared
+	};
+
+	/**
+	 * @brief Check if a board matches a success state reduced to bit masks
+	 */
+	inline bool matchesMask(board_t board, const GoalMask& goal) {
+		return (board & goal.mask) == goal.value;
+	}
+
 	bool isSuccessState(board_t board, const std::string& target);
 	bool matchesSuccessState(board_t board, const std::string& state);
+	int mismatchedTiles(board_t board, const std::string& state);
+	int lowerBound(board_t board, const std::string& target);
+	int lowerBound(board_t board, const std::vector<std::string>& states);
+
+	const std::vector<std::string>& cardIDs();
+	int cardIndex(const std::string& target);
+	std::vector<uint32_t> goalStates(const std::string& target);
+
+	GoalMask goalMask(const std::string& state);
+	const std::vector<GoalMask>& goalMasks(const std::string& target);
+	bool matchesAny(board_t board, const std::vector<GoalMask>& goals);
+	int lowerBound(board_t board, const std::vector<GoalMask>& goals);
 
 	const std::unordered_map<std::string, std::vector<std::string>> SUCCESS_STATES = {
 		{"888548888", {"888548888", "888854888", "548888888", "854888888", "888888548", "888888854"}},
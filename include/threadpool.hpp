@@ -0,0 +1,64 @@
+//
+// FILENAME: threadpool.hpp | Shifting Stones Search
+// DESCRIPTION: A work-stealing thread pool for background searches
+// CREATED: 2026-10-21 @ 10:20 AM
+//
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace threadpool {
+	using task_t = std::function<void()>;
+
+	/**
+	 * @brief A fixed set of workers that each own a task queue and steal from the others when theirs is empty
+	 *
+	 * @note  Tasks submitted from a worker go to the front of its own queue and are run first, which keeps work spawned
+	 * 		  by a task on the same core. Tasks submitted from other threads are spread across the queues. Idle workers
+	 * 		  take the oldest task from the back of another queue.
+	 */
+	class ThreadPool {
+	public:
+		explicit ThreadPool(unsigned threads = 0);
+		~ThreadPool();
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		void submit(task_t task);
+
+		std::size_t size() const { return queues.size(); }
+		std::size_t pending() const { return queued.load(std::memory_order_relaxed); }
+
+	private:
+		/**
+		 * @struct __worker_queue
+		 * @brief The tasks owned by one worker
+		 */
+		struct __worker_queue {
+			std::mutex 			lock;
+			std::deque<task_t> 	tasks; // The owner runs from the front, thieves take from the back
+		};
+
+		std::vector<std::unique_ptr<__worker_queue>> 	queues;
+		std::vector<std::jthread> 						workers;
+
+		std::mutex 					sleepLock;
+		std::condition_variable 	wake;
+		std::atomic<std::size_t> 	queued = 0; 	// The number of tasks waiting in all queues
+		std::atomic<std::size_t> 	nextQueue = 0; 	// The queue the next outside submission goes to
+		bool 						stopping = false;
+
+		bool take(std::size_t worker, task_t& task);
+		void run(std::size_t worker);
+	};
+}
@@ -0,0 +1,88 @@
+//
+// FILENAME: transposition.hpp | Shifting Stones Search
+// DESCRIPTION: A lock-free transposition table shared by search threads
+// CREATED: 2026-10-21 @ 2:15 PM
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "decl.h"
+
+namespace transposition {
+	/**
+	 * @brief The number of entries probed for each (board, card) pair
+	 */
+	const std::size_t BUCKET_SIZE = 4;
+
+	/**
+	 * @brief The deepest remaining search depth an entry can record
+	 */
+	const int MAX_DEPTH = 63;
+
+	/**
+	 * @brief What an entry's value says about the true value
+	 */
+	enum class Bound : uint8_t {
+		None, 	// The entry is empty
+		Exact, 	// The value is exact
+		Lower, 	// The true value is at least the stored value
+		Upper 	// The true value is at most the stored value
+	};
+
+	/**
+	 * @struct Entry
+	 * @brief A decoded table entry
+	 */
+	struct Entry {
+		board_t board = 0;
+		int 	card = 0; 				// The index of the target card in `success_states::cardIDs`
+		int 	value = 0; 				// The stored value, from -128 to 127
+		Bound 	bound = Bound::None;
+		int 	move = 0; 				// The best known move (1 - 21), or 0 if there is none
+		int 	depth = 0; 				// The remaining depth the value was searched to
+		uint8_t age = 0; 				// The table generation the entry was written in
+	};
+
+	uint64_t pack(const Entry& entry);
+	Entry unpack(uint64_t word);
+
+	/**
+	 * @brief A fixed-size table of search results keyed by board and target card
+	 *
+	 * @note  Every entry is a single 64-bit word, so threads read and write entries with plain atomic loads and stores
+	 * 		  and never see a torn entry. A lost update only costs a repeated search.
+	 */
+	class TranspositionTable {
+	public:
+		explicit TranspositionTable(std::size_t megabytes = 64);
+
+		bool probe(board_t board, int card, Entry& entry) const;
+		void store(board_t board, int card, int value, Bound bound, int move, int depth);
+
+		void newSearch();
+		void clear();
+
+		std::size_t capacity() const { return buckets * BUCKET_SIZE; }
+		uint8_t generation() const { return age.load(std::memory_order_relaxed); }
+
+	private:
+		/**
+		 * @struct __bucket
+		 * @brief The entries sharing a hash slot, kept in one half cache line
+		 */
+		struct alignas(BUCKET_SIZE * sizeof(uint64_t)) __bucket {
+			std::atomic<uint64_t> slots[BUCKET_SIZE];
+		};
+
+		std::unique_ptr<__bucket[]> table;
+		std::size_t 				buckets;
+		std::atomic<uint8_t> 		age = 0;
+
+		__bucket& bucketFor(board_t board, int card) const;
+	};
+}
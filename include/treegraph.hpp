@@ -21,6 +21,7 @@
 #include <cgraph/cgraph.h>
 
 #include "decl.h"
+#include "subgraph.hpp"
 #include "treeutils.hpp"
 
 /**
@@ -132,6 +133,26 @@ public:
 		storeTree(tree);
 	}
 
+	/**
+	 * @brief Construct a new `Tree` object from an extracted subgraph
+	 * 
+	 * @param 	graph 	The subgraph to store. Every edge is inserted in a single pass.
+	 * 
+	 * @note 			Use `boost::directedS` for the subgraphs returned by `subgraph::optimalDAG`
+	 */
+	explicit TreeGraph(const subgraph::Subgraph& graph):
+		tree(graph.edges.begin(), graph.edges.end(), graph.boards.size())
+	{
+		for (std::size_t vertex = 0; vertex < graph.boards.size(); vertex++) {
+			// The vertex doesn't come from a tree buffer, so it has no parent or child index
+			this->tree[vertex] = vertex_type {graph.boards[vertex], -1, -1};
+
+			const char* bits = treeutils::getBits(graph.boards[vertex], 27);
+			vertexLabels[vertex] = std::string(bits);
+			free((void*)bits);
+		}
+	}
+
 	/**
 	 * @brief Destroy the `Tree` object
 	 * 
@@ -159,8 +180,10 @@ public:
 			boost::add_edge(parent, PARENT_INDEX + child, this->tree);
 		}
 
-		// Map the node to a strigified version of its board
-		vertexLabels[descriptor] = std::string(treeutils::getBits(board, 27));
+		// Map the node to a strigified version of its board. `getBits` allocates the string, so it's freed once copied.
+		const char* bits = treeutils::getBits(board, 27);
+		vertexLabels[descriptor] = std::string(bits);
+		free((void*)bits);
 
 		return descriptor;
 	}
@@ -11,7 +11,9 @@
 #include <cstdint>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <queue>
+#include <random>
 #include <tuple>
 #include <utility>
 #include <vector>
@@ -20,6 +22,10 @@
 #include "decl.h"
 #include "successstates.hpp"
 
+namespace policy {
+	class PolicyTable;
+}
+
 namespace treeutils {
 	namespace __detail {
 		/**
@@ -57,6 +63,8 @@ namespace treeutils {
 
 	int isValidBoardState(board_t board);
 
+	board_t randomBoard(std::mt19937_64& random);
+
 	/**
 	 * @brief Get a specific board from the tree
 	 * 
@@ -106,7 +114,7 @@ namespace treeutils {
 		return buffer;
 	}
 
-	std::tuple<board_t, std::vector<int>> search(const tree_t tree, const std::string& target);
+	std::tuple<board_t, std::vector<int>> search(const tree_t tree, const std::string& target, const policy::PolicyTable* policy = nullptr);
 	
 	board_t findSuccessState(board_t initialBoard, const std::string& successState);
 	
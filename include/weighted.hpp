@@ -0,0 +1,60 @@
+//
+// FILENAME: weighted.hpp | Shifting Stones Search
+// DESCRIPTION: Cheapest-cost search with small integer move costs
+// CREATED: 2026-10-23 @ 3:40 PM
+//
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "decl.h"
+#include "neighbors.hpp"
+#include "solver.hpp"
+
+namespace weighted {
+	/**
+	 * @brief The number of swap moves. Moves 1 - 12 swap two tiles and moves 13 - 21 flip one.
+	 */
+	const int SWAP_MOVES = 12;
+
+	/**
+	 * @brief The largest cost a single move can have
+	 */
+	const int MAX_MOVE_COST = 15;
+
+	/**
+	 * @brief The cost reported for states that can't be reached
+	 */
+	const uint16_t UNREACHED = 0xFFFF;
+
+	/**
+	 * @brief The move recorded for the states a search starts from
+	 */
+	const uint8_t SOURCE_MOVE = 0xFF;
+
+	/**
+	 * @brief The cost of each move, indexed by move - 1
+	 */
+	using MoveCosts = std::array<uint8_t, POSSIBLE_CONFIGS>;
+
+	MoveCosts makeCosts(int swapCost = 1, int flipCost = 1);
+
+	/**
+	 * @struct Solution
+	 * @brief The result of a weighted search
+	 */
+	struct Solution {
+		solver::Status 	 status = solver::Status::Unsolvable;
+		board_t 		 board = 0; // The success state reached, the best partial board, or 0 if neither
+		std::vector<int> moves; 	// The moves leading to `board`, in the order they are applied
+		int 			 cost = 0; 	// The total cost of `moves`
+	};
+
+	Solution solve(board_t board, const std::string& target, const MoveCosts& costs, const solver::Budget& budget = {}, const neighbors::NeighborTable* table = nullptr);
+	std::vector<uint16_t> distances(const neighbors::NeighborTable& table, const std::vector<std::pair<uint32_t, int>>& sources, const MoveCosts& costs, std::vector<uint8_t>* reachedBy = nullptr);
+}
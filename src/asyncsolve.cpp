@@ -0,0 +1,75 @@
+//
+// FILENAME: asyncsolve.cpp | Shifting Stones Search
+// DESCRIPTION: Non-blocking (board, card) queries with cancellation and deadlines
+// CREATED: 2026-10-21 @ 11:40 AM
+//
+
+#include "asyncsolve.hpp"
+
+#include <memory>
+
+#include "idastar.hpp"
+
+namespace asyncsolve {
+	namespace __detail {
+		/**
+		 * @brief Run a query with the search its options ask for
+		 */
+		solver::Solution run(board_t board, const std::string& target, std::stop_token stop, const Options& options) {
+			const solver::Budget BUDGET = {std::move(stop), options.deadline, options.maxNodes, options.maxMemory};
+
+			if (options.transpositions) {
+				return idastar::solve(board, target, BUDGET, options.transpositions);
+			}
+
+			return solver::solve(board, target, BUDGET, options.table);
+		}
+	}
+
+	/**
+	 * @brief Start a query in the background
+	 *
+	 * @param 	pool 	The pool to run the search on
+	 * @param 	board 	The starting board
+	 * @param 	target 	The ID of the target card
+	 * @param 	options The query settings
+	 * @return 			A handle to the running query
+	 */
+	PendingSolve solveAsync(threadpool::ThreadPool& pool, board_t board, const std::string& target, const Options& options) {
+		auto promise = std::make_shared<std::promise<solver::Solution>>();
+		std::stop_source stop;
+		PendingSolve pending(promise->get_future(), stop);
+
+		pool.submit([promise, stop, board, target, options]() {
+			promise->set_value(__detail::run(board, target, stop.get_token(), options));
+		});
+
+		return pending;
+	}
+
+	/**
+	 * @brief Start the search and resume the coroutine once it finishes
+	 *
+	 * @param 	handle 	The suspended coroutine
+	 */
+	void SolveAwaiter::await_suspend(std::coroutine_handle<> handle) {
+		pool.submit([this, handle]() {
+			result = __detail::run(board, target, stop, options);
+			handle.resume();
+		});
+	}
+
+	/**
+	 * @brief Create an awaitable query
+	 *
+	 * @param 	pool 	The pool to run the search on
+	 * @param 	board 	The starting board
+	 * @param 	target 	The ID of the target card
+	 * @param 	options The query settings
+	 * @param 	stop 	Ends the search early when stop is requested
+	 * @return 			An object to `co_await`, which yields the `solver::Solution`
+	 */
+	SolveAwaiter solveAwaitable(threadpool::ThreadPool& pool, board_t board, const std::string& target, const Options& options, std::stop_token stop) {
+		return SolveAwaiter(pool, board, target, options, std::move(stop));
+	}
+}
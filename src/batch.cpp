@@ -0,0 +1,176 @@
+//
+// FILENAME: batch.cpp | Shifting Stones Search
+// DESCRIPTION: Solve large batches of (board, card) queries
+// CREATED: 2026-10-20 @ 3:10 PM
+//
+
+#include "batch.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include "successstates.hpp"
+#include "treeutils.hpp"
+
+namespace batch {
+	/**
+	 * @brief Pack a move list into a single word
+	 *
+	 * @param 	moves 	The moves (1 - 21) to pack
+	 * @return 			The packed moves, with the first move in the lowest bits
+	 *
+	 * @note 			Only the first `MAX_ENCODED_MOVES` moves are stored
+	 */
+	uint64_t encodeMoves(const std::vector<int>& moves) {
+		uint64_t encoded = 0;
+
+		for (std::size_t i = 0; i < moves.size() && i < MAX_ENCODED_MOVES; i++) {
+			encoded |= (uint64_t)moves[i] << (MOVE_BITS * i);
+		}
+
+		return encoded;
+	}
+
+	/**
+	 * @brief Unpack a move list packed by `encodeMoves`
+	 *
+	 * @param 	encoded The packed moves
+	 * @param 	count 	The number of moves stored
+	 * @return 			The moves, in the order they are applied
+	 */
+	std::vector<int> decodeMoves(uint64_t encoded, int count) {
+		std::vector<int> moves(std::min(count, MAX_ENCODED_MOVES));
+
+		for (std::size_t i = 0; i < moves.size(); i++) {
+			moves[i] = (encoded >> (MOVE_BITS * i)) & ((1 << MOVE_BITS) - 1);
+		}
+
+		return moves;
+	}
+
+	/**
+	 * @brief Create a batch engine
+	 *
+	 * @param 	table 	A loaded neighbor table. It must outlive the engine.
+	 * @param 	options The engine settings
+	 */
+	BatchEngine::BatchEngine(const neighbors::NeighborTable& table, const Options& options):
+		table(table),
+		options(options)
+	{
+		this->options.threads = options.threads? options.threads : std::max(1U, std::thread::hardware_concurrency());
+	}
+
+	/**
+	 * @brief Get the policy table for a card, loading or building it if it isn't cached
+	 *
+	 * @param 	card 	The index of the card in `success_states::cardIDs`
+	 * @return 			The policy table
+	 */
+	const policy::PolicyTable& BatchEngine::policyFor(int card) {
+		auto cached = std::find_if(tables.begin(), tables.end(), [card](const cached_table& entry) {
+			return entry.first == card;
+		});
+
+		if (cached != tables.end()) {
+			tables.splice(tables.begin(), tables, cached);
+			return *tables.front().second;
+		}
+
+		const std::string& target = success_states::cardIDs()[card];
+		auto loaded = std::make_unique<policy::PolicyTable>();
+
+		if (options.policyDirectory.empty() || !loaded->load(policy::policyPath(options.policyDirectory, target))
+			|| loaded->target() != target) {
+			loaded->build(table, target, options.threads);
+		}
+
+		tables.emplace_front(card, std::move(loaded));
+		while (tables.size() > std::max<std::size_t>(options.maxTables, 1)) {
+			tables.pop_back();
+		}
+
+		return *tables.front().second;
+	}
+
+	/**
+	 * @brief Solve a batch of queries
+	 *
+	 * @param 	boards 		The starting board of each query
+	 * @param 	cards 		The index of each query's target card in `success_states::cardIDs`
+	 * @param 	count 		The number of queries
+	 * @param 	moveCounts 	Filled with the optimal number of moves for each query, or `UNSOLVED`
+	 * @param 	moveLists 	Filled with an optimal move list for each query, packed by `encodeMoves`
+	 *
+	 * @note 				Queries with an invalid board or card are reported as `UNSOLVED`
+	 */
+	void BatchEngine::solve(const board_t* boards, const int* cards, std::size_t count, uint8_t* moveCounts, uint64_t* moveLists) {
+		const int CARDS = success_states::cardIDs().size();
+
+		// Bucket the queries by card
+		std::vector<std::size_t> offsets(CARDS + 2, 0);
+		for (std::size_t i = 0; i < count; i++) {
+			offsets[(cards[i] >= 0 && cards[i] < CARDS)? cards[i] + 2 : 1]++;
+		}
+
+		for (int card = 0; card <= CARDS; card++) {
+			offsets[card + 1] += offsets[card];
+		}
+
+		std::vector<std::size_t> order(count);
+		for (std::size_t i = 0; i < count; i++) {
+			order[offsets[(cards[i] >= 0 && cards[i] < CARDS)? cards[i] + 1 : 0]++] = i;
+		}
+
+		// The first bucket holds queries for unknown cards
+		for (std::size_t i = 0; i < offsets[0]; i++) {
+			moveCounts[order[i]] = UNSOLVED;
+			moveLists[order[i]] = 0;
+		}
+
+		for (int card = 0; card < CARDS; card++) {
+			const std::size_t FIRST = offsets[card], LAST = offsets[card + 1];
+
+			if (FIRST == LAST) {
+				continue;
+			}
+
+			const policy::PolicyTable& policy = policyFor(card);
+			std::atomic<std::size_t> next = FIRST;
+
+			auto work = [&]() {
+				for (std::size_t i = next++; i < LAST; i = next++) {
+					const std::size_t QUERY = order[i];
+					int index = treeutils::isValidBoardState(boards[QUERY]);
+
+					if (index == -1 || policy.distance(index) == policy::UNSOLVABLE) {
+						moveCounts[QUERY] = UNSOLVED;
+						moveLists[QUERY] = 0;
+						continue;
+					}
+
+					moveCounts[QUERY] = policy.distance(index);
+					uint64_t encoded = 0;
+
+					for (int move = policy.bestMove(index), step = 0; move != 0; move = policy.bestMove(index), step++) {
+						if (step < MAX_ENCODED_MOVES) {
+							encoded |= (uint64_t)move << (MOVE_BITS * step);
+						}
+
+						index = table.neighbor(index, move);
+					}
+
+					moveLists[QUERY] = encoded;
+				}
+			};
+
+			std::vector<std::jthread> workers;
+			for (unsigned t = 1; t < std::min<std::size_t>(options.threads, LAST - FIRST); t++) {
+				workers.emplace_back(work);
+			}
+
+			work();
+		}
+	}
+}
@@ -0,0 +1,205 @@
+//
+// FILENAME: bitbfs.cpp | Shifting Stones Search
+// DESCRIPTION: Set-at-a-time breadth-first search over bitsets of state indices
+// CREATED: 2026-10-19 @ 1:05 PM
+//
+
+#include "bitbfs.hpp"
+
+#include <algorithm>
+#include <thread>
+
+namespace bitbfs {
+	namespace __detail {
+		/**
+		 * @brief Switch to pulling once the frontier's edges exceed this fraction of the unvisited states
+		 *
+		 * @note  Pushing touches only the frontier's rows, pulling touches every unvisited row but stops at the
+		 * 		  first neighbor found in the frontier
+		 */
+		const std::size_t PULL_RATIO = 14;
+
+		/**
+		 * @brief The valid bits of the last word in a `StateSet`
+		 */
+		const uint64_t TAIL_MASK = (MAX_BOARD_STATES % 64 == 0)? ~0ULL : (1ULL << (MAX_BOARD_STATES % 64)) - 1;
+
+		/**
+		 * @brief Run a function over evenly sized slices of the words in a `StateSet`
+		 *
+		 * @param 	threads 	The number of threads to use, or 0 for one per hardware thread
+		 * @param 	work 		Called with the first and one-past-last word of each slice
+		 */
+		template<class Work>
+		void forSlices(unsigned threads, Work&& work) {
+			threads = threads? threads : std::max(1U, std::thread::hardware_concurrency());
+			const std::size_t SLICE = (STATE_WORDS + threads - 1) / threads;
+
+			std::vector<std::jthread> workers;
+			for (unsigned t = 1; t < threads; t++) {
+				workers.emplace_back(work, std::min(STATE_WORDS, t * SLICE), std::min(STATE_WORDS, (t + 1) * SLICE));
+			}
+
+			work(0, std::min(STATE_WORDS, SLICE));
+		}
+	}
+
+	/**
+	 * @brief Count the states in the set
+	 */
+	std::size_t StateSet::count() const {
+		std::size_t total = 0;
+		for (uint64_t word: words) {
+			total += std::popcount(word);
+		}
+
+		return total;
+	}
+
+	/**
+	 * @brief Check if the set holds no states
+	 */
+	bool StateSet::empty() const {
+		return std::all_of(words.begin(), words.end(), [](uint64_t word) { return word == 0; });
+	}
+
+	/**
+	 * @brief Add every state in another set
+	 */
+	StateSet& StateSet::operator|=(const StateSet& other) {
+		for (std::size_t i = 0; i < STATE_WORDS; i++) {
+			words[i] |= other.words[i];
+		}
+
+		return *this;
+	}
+
+	/**
+	 * @brief Keep only the states also in another set
+	 */
+	StateSet& StateSet::operator&=(const StateSet& other) {
+		for (std::size_t i = 0; i < STATE_WORDS; i++) {
+			words[i] &= other.words[i];
+		}
+
+		return *this;
+	}
+
+	/**
+	 * @brief Remove every state in another set
+	 */
+	StateSet& StateSet::subtract(const StateSet& other) {
+		for (std::size_t i = 0; i < STATE_WORDS; i++) {
+			words[i] &= ~other.words[i];
+		}
+
+		return *this;
+	}
+
+	/**
+	 * @brief Find every unvisited state one move away from a frontier
+	 *
+	 * @param 	table 		A loaded neighbor table
+	 * @param 	frontier 	The states to expand
+	 * @param 	visited 	Every state already reached, including the frontier
+	 * @param 	threads 	The number of threads to use when pulling, or 0 for one per hardware thread
+	 * @return 				The next frontier
+	 *
+	 * @note
+	 * Small frontiers push: each frontier state sets the bits of its neighbors, and the visited set is removed
+	 * from the result with one word-wise pass. Large frontiers pull: each unvisited state checks its own row for a
+	 * neighbor in the frontier. Pulling writes whole words owned by a single thread, so it runs in parallel without
+	 * atomics. Every move is its own inverse, so a state's row lists exactly the states that can reach it.
+	 */
+	StateSet expand(const neighbors::NeighborTable& table, const StateSet& frontier, const StateSet& visited, unsigned threads) {
+		StateSet next;
+		const std::size_t FRONTIER_EDGES = frontier.count() * POSSIBLE_CONFIGS;
+		const std::size_t UNVISITED = MAX_BOARD_STATES - visited.count();
+
+		if (FRONTIER_EDGES * __detail::PULL_RATIO < UNVISITED) {
+			frontier.forEach([&](uint32_t index) {
+				const uint32_t* row = table.row(index);
+
+				for (std::size_t move = 0; move < POSSIBLE_CONFIGS; move++) {
+					next.set(row[move]);
+				}
+			});
+
+			return next.subtract(visited);
+		}
+
+		uint64_t* out = next.data();
+		const uint64_t* seen = visited.data();
+
+		__detail::forSlices(threads, [&](std::size_t first, std::size_t last) {
+			for (std::size_t i = first; i < last; i++) {
+				uint64_t word = 0;
+				uint64_t open = ~seen[i] & ((i == STATE_WORDS - 1)? __detail::TAIL_MASK : ~0ULL);
+
+				for (; open != 0; open &= open - 1) {
+					const int BIT = std::countr_zero(open);
+					const uint32_t* row = table.row(64 * i + BIT);
+
+					for (std::size_t move = 0; move < POSSIBLE_CONFIGS; move++) {
+						if (frontier.test(row[move])) {
+							word |= 1ULL << BIT;
+							break;
+						}
+					}
+				}
+
+				out[i] = word;
+			}
+		});
+
+		return next;
+	}
+
+	/**
+	 * @brief Generate every breadth-first level reachable from a set of states
+	 *
+	 * @param 	table 		A loaded neighbor table
+	 * @param 	start 		The states making up level 0
+	 * @param 	maxDepth 	The deepest level to generate, or -1 for no limit
+	 * @param 	threads 	The number of threads to use, or 0 for one per hardware thread
+	 * @return 				The levels, in order of depth
+	 */
+	std::vector<StateSet> levels(const neighbors::NeighborTable& table, const StateSet& start, int maxDepth, unsigned threads) {
+		std::vector<StateSet> result = {start};
+		StateSet visited = start;
+
+		while (maxDepth < 0 || (int)result.size() <= maxDepth) {
+			StateSet next = expand(table, result.back(), visited, threads);
+
+			if (next.empty()) {
+				break;
+			}
+
+			visited |= next;
+			result.push_back(std::move(next));
+		}
+
+		return result;
+	}
+
+	/**
+	 * @brief Find every state reachable from a set of states within a number of moves
+	 *
+	 * @param 	table 		A loaded neighbor table
+	 * @param 	start 		The starting states
+	 * @param 	moves 		The largest number of moves allowed
+	 * @param 	threads 	The number of threads to use, or 0 for one per hardware thread
+	 * @return 				The reachable states, including `start`
+	 */
+	StateSet reachableWithin(const neighbors::NeighborTable& table, const StateSet& start, int moves, unsigned threads) {
+		StateSet visited = start;
+		StateSet frontier = start;
+
+		for (int depth = 0; depth < moves && !frontier.empty(); depth++) {
+			frontier = expand(table, frontier, visited, threads);
+			visited |= frontier;
+		}
+
+		return visited;
+	}
+}
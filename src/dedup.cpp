@@ -0,0 +1,208 @@
+//
+// FILENAME: dedup.cpp | Shifting Stones Search
+// DESCRIPTION: Sort-based deduplication of breadth-first levels
+// CREATED: 2026-10-18 @ 11:02 AM
+//
+
+#include "dedup.hpp"
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <optional>
+
+#include "treeutils.hpp"
+
+namespace dedup {
+	/**
+	 * @brief Sort a set of boards with an LSD radix sort over the 27 usable bits
+	 *
+	 * @param 	boards 	The boards to sort
+	 *
+	 * @note 			All three histograms are built in a single read of the input, then each pass
+	 * 					scatters into a scratch buffer of the same size
+	 */
+	void radixSort(std::vector<board_t>& boards) {
+		const int PASSES = USABLE_BOARD / RADIX_BITS;
+		const board_t MASK = RADIX_BUCKETS - 1;
+
+		std::array<std::array<std::size_t, RADIX_BUCKETS>, PASSES> counts = {};
+		for (board_t board: boards) {
+			for (int pass = 0; pass < PASSES; pass++) {
+				counts[pass][(board >> (pass * RADIX_BITS)) & MASK]++;
+			}
+		}
+
+		std::vector<board_t> scratch(boards.size());
+
+		for (int pass = 0; pass < PASSES; pass++) {
+			const int SHIFT = pass * RADIX_BITS;
+
+			// Turn the histogram into starting offsets
+			std::size_t offset = 0;
+			for (auto& count: counts[pass]) {
+				std::size_t bucket = count;
+				count = offset;
+				offset += bucket;
+			}
+
+			for (board_t board: boards) {
+				scratch[counts[pass][(board >> SHIFT) & MASK]++] = board;
+			}
+
+			boards.swap(scratch);
+		}
+	}
+
+	/**
+	 * @brief Sort a set of boards and remove duplicates
+	 *
+	 * @param 	boards 	The boards to sort
+	 */
+	void sortUnique(std::vector<board_t>& boards) {
+		radixSort(boards);
+		boards.erase(std::unique(boards.begin(), boards.end()), boards.end());
+	}
+
+	/**
+	 * @brief Remove every board found in a visited set
+	 *
+	 * @param 	boards 	A sorted, duplicate-free set of boards to filter
+	 * @param 	visited A sorted set of boards to remove
+	 *
+	 * @note 			Both sets are walked in a single merge pass, and `boards` is filtered in place
+	 */
+	void subtract(std::vector<board_t>& boards, const std::vector<board_t>& visited) {
+		std::size_t kept = 0;
+		auto seen = visited.begin();
+
+		for (board_t board: boards) {
+			while (seen != visited.end() && *seen < board) {
+				seen++;
+			}
+
+			if (seen == visited.end() || *seen != board) {
+				boards[kept++] = board;
+			}
+		}
+
+		boards.resize(kept);
+	}
+
+	/**
+	 * @brief Generate every breadth-first level reachable from a set of boards
+	 *
+	 * @param 	start 		The boards making up level 0
+	 * @param 	maxDepth 	The deepest level to generate, or -1 for no limit
+	 * @param 	chunkSize 	The number of generated boards sorted at once
+	 * @return 				The levels, in order of depth
+	 *
+	 * @note 				Every move is its own inverse, so subtracting the previous two levels removes
+	 * 						every visited board without a random-access visited structure
+	 * @note 				Only one chunk of uncompressed boards is held at a time. Sorted chunks are
+	 * 						compressed straight away and merged into the next level.
+	 */
+	std::vector<frontier::CompressedFrontier> levels(const std::vector<board_t>& start, int maxDepth, std::size_t chunkSize) {
+		std::vector<frontier::CompressedFrontier> result(1);
+		std::vector<board_t> chunk = start;
+
+		sortUnique(chunk);
+		for (board_t board: chunk) {
+			result.back().push(board);
+		}
+		result.back().finish();
+
+		while (!result.back().empty() && (maxDepth < 0 || (int)result.size() <= maxDepth)) {
+			const frontier::CompressedFrontier& current = result.back();
+			std::vector<frontier::CompressedFrontier> runs;
+
+			auto spill = [&]() {
+				sortUnique(chunk);
+				runs.emplace_back();
+
+				for (board_t board: chunk) {
+					runs.back().push(board);
+				}
+
+				runs.back().finish();
+				chunk.clear();
+			};
+
+			chunk.clear();
+			chunk.reserve(chunkSize);
+
+			frontier::CompressedFrontier::Cursor parents(current);
+			for (board_t board; parents.next(board);) {
+				for (int i = 1; i <= (int)POSSIBLE_CONFIGS; i++) {
+					chunk.push_back(treeutils::__permuteBoard(board, i));
+				}
+
+				if (chunk.size() + POSSIBLE_CONFIGS > chunkSize) {
+					spill();
+				}
+			}
+
+			if (!chunk.empty()) {
+				spill();
+			}
+
+			// Merge the sorted runs, dropping duplicates and anything in the previous two levels
+			std::vector<frontier::CompressedFrontier::Cursor> cursors;
+			std::vector<std::pair<board_t, std::size_t>> heads;
+			cursors.reserve(runs.size());
+
+			for (std::size_t i = 0; i < runs.size(); i++) {
+				cursors.emplace_back(runs[i]);
+
+				if (board_t board; cursors.back().next(board)) {
+					heads.emplace_back(board, i);
+				}
+			}
+
+			auto later = std::greater<std::pair<board_t, std::size_t>>();
+			std::make_heap(heads.begin(), heads.end(), later);
+
+			frontier::CompressedFrontier::Cursor now(current);
+			std::optional<frontier::CompressedFrontier::Cursor> before;
+			if (result.size() > 1) {
+				before.emplace(result[result.size() - 2]);
+			}
+
+			frontier::CompressedFrontier next;
+			bool first = true;
+			board_t last = 0;
+
+			while (!heads.empty()) {
+				std::pop_heap(heads.begin(), heads.end(), later);
+				auto [board, run] = heads.back();
+				heads.pop_back();
+
+				if (board_t following; cursors[run].next(following)) {
+					heads.emplace_back(following, run);
+					std::push_heap(heads.begin(), heads.end(), later);
+				}
+
+				if ((!first && board == last) || now.contains(board) || (before && before->contains(board))) {
+					continue;
+				}
+
+				first = false;
+				last = board;
+				next.push(board);
+			}
+
+			next.finish();
+			cursors.clear();
+			before.reset();
+
+			result.push_back(std::move(next));
+		}
+
+		// The final level is empty
+		if (result.size() > 1 && result.back().empty()) {
+			result.pop_back();
+		}
+
+		return result;
+	}
+}
@@ -0,0 +1,266 @@
+//
+// FILENAME: difficulty.cpp | Shifting Stones Search
+// DESCRIPTION: Exact solution-length statistics of every card over every starting board
+// CREATED: 2026-10-25 @ 10:05 AM
+//
+
+#include "difficulty.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <thread>
+
+#include "boardstates.h"
+#include "successstates.hpp"
+
+namespace difficulty {
+	namespace __detail {
+		/**
+		 * @brief Identifies a stored report file
+		 */
+		const char REPORT_MAGIC[4] = {'S', 'S', 'D', 'R'};
+		const uint32_t REPORT_VERSION = 1;
+
+		/**
+		 * @brief The card ID length stored in a report record
+		 */
+		const std::size_t CARD_ID_SIZE = 12;
+
+		/**
+		 * @struct __report_header
+		 * @brief The header written in front of a stored report
+		 */
+		struct __report_header {
+			char 	 magic[4];
+			uint32_t version;
+			uint32_t count; 		// The number of records that follow
+			uint32_t maxDistance; 	// `MAX_DISTANCE`, so readers know the histogram length
+			uint32_t maxWorst; 		// `MAX_WORST`, so readers know the worst-board length
+		};
+
+		/**
+		 * @struct __report_record
+		 * @brief One card's report as stored. Unused worst boards are 0.
+		 */
+		struct __report_record {
+			char 	 card[CARD_ID_SIZE]; 	// The null-terminated card ID
+			uint32_t histogram[MAX_DISTANCE + 1];
+			uint32_t unsolvable;
+			uint32_t maxDistance;
+			uint32_t worstCount;
+			uint32_t worstBoards[MAX_WORST];
+		};
+
+		/**
+		 * @brief Summarize the distances from every state to a card
+		 *
+		 * @param 	distance 	The distance of every state, in `BOARD_STATES` order
+		 * @return 				The report, without the card ID
+		 */
+		CardReport __summarize(const std::vector<uint8_t>& distance) {
+			CardReport report;
+			uint64_t total = 0;
+
+			for (uint32_t state = 0; state < MAX_BOARD_STATES; state++) {
+				const int DISTANCE = distance[state];
+
+				if (DISTANCE == neighbors::UNREACHED) {
+					report.unsolvable++;
+					continue;
+				}
+
+				if (DISTANCE > MAX_DISTANCE) {
+					report.overflow++;
+				}
+				else {
+					report.histogram[DISTANCE]++;
+				}
+
+				total += DISTANCE;
+
+				if (DISTANCE > report.maxDistance) {
+					report.maxDistance = DISTANCE;
+					report.worstCount = 0;
+					report.worstBoards.clear();
+				}
+
+				if (DISTANCE == report.maxDistance && report.worstCount++ < MAX_WORST) {
+					report.worstBoards.push_back(BOARD_STATES[state]);
+				}
+			}
+
+			const uint32_t SOLVABLE = MAX_BOARD_STATES - report.unsolvable;
+			report.meanDistance = SOLVABLE? (double)total / SOLVABLE : 0;
+
+			return report;
+		}
+	}
+
+	/**
+	 * @brief Find the best solution length of every card from every starting board
+	 *
+	 * @param 	table 	A loaded neighbor table
+	 * @param 	cards 	The IDs of the cards to report on, or every card if empty. Unknown IDs are skipped.
+	 * @param 	threads The number of threads, or 0 for one per hardware thread
+	 * @return 			One report per card, in the order the cards were given
+	 *
+	 * @note 			Every move is its own inverse, so one backward search from a card's success states gives the
+	 * 					best solution length from every board at once. Cards with the same success states share a
+	 * 					search, and the searches run in parallel with one distance table per thread.
+	 */
+	std::vector<CardReport> sweep(const neighbors::NeighborTable& table, const std::vector<std::string>& cards, unsigned threads) {
+		threads = threads? threads : std::max(1U, std::thread::hardware_concurrency());
+
+		std::vector<CardReport> reports;
+		std::map<std::vector<std::string>, std::vector<std::size_t>> groups; // The reports sharing each set of success states
+
+		for (const std::string& card: cards.empty()? success_states::cardIDs() : cards) {
+			auto found = success_states::SUCCESS_STATES.find(card);
+
+			if (found == success_states::SUCCESS_STATES.end()) {
+				continue;
+			}
+
+			std::vector<std::string> states = found->second;
+			std::sort(states.begin(), states.end());
+
+			groups[states].push_back(reports.size());
+			reports.push_back({});
+			reports.back().card = card;
+		}
+
+		std::vector<const std::vector<std::size_t>*> work;
+		for (const auto& [_, members]: groups) {
+			work.push_back(&members);
+		}
+
+		std::atomic<std::size_t> next = 0;
+
+		auto worker = [&]() {
+			for (std::size_t group = next++; group < work.size(); group = next++) {
+				const std::vector<std::size_t>& members = *work[group];
+				CardReport report = __detail::__summarize(neighbors::distances(table, success_states::goalStates(reports[members[0]].card)));
+
+				for (std::size_t member: members) {
+					report.card = reports[member].card;
+					reports[member] = report;
+				}
+			}
+		};
+
+		{
+			std::vector<std::jthread> workers;
+			for (unsigned t = 0; t < std::min<std::size_t>(threads, work.size()); t++) {
+				workers.emplace_back(worker);
+			}
+		}
+
+		return reports;
+	}
+
+	/**
+	 * @brief Check if any report has solutions too long for its histogram
+	 *
+	 * @param 	reports The reports to check
+	 * @return 			`true` if a report has an `overflow`, `false` otherwise
+	 */
+	bool overflows(const std::vector<CardReport>& reports) {
+		return std::any_of(reports.begin(), reports.end(), [](const CardReport& report) {
+			return report.overflow != 0;
+		});
+	}
+
+	/**
+	 * @brief Store reports as comma-separated values
+	 *
+	 * @param 	reports The reports to store
+	 * @param 	path 	The file to write
+	 * @return 			`true` if the file was written, `false` otherwise or if any report has an `overflow`
+	 *
+	 * @note 			Each row holds the card ID, the unsolvable count, the histogram from 0 to `MAX_DISTANCE`, the
+	 * 					longest and mean solution lengths, the worst-case count, and the stored worst-case boards as
+	 * 					decimal integers separated by spaces
+	 */
+	bool writeCSV(const std::vector<CardReport>& reports, const std::string& path) {
+		if (overflows(reports)) {
+			return false;
+		}
+
+		FILE* file = fopen(path.c_str(), "w");
+		if (!file) {
+			return false;
+		}
+
+		bool written = fprintf(file, "card,unsolvable") >= 0;
+		for (int distance = 0; distance <= MAX_DISTANCE; distance++) {
+			written = written && fprintf(file, ",d%d", distance) >= 0;
+		}
+		written = written && fprintf(file, ",max,mean,worst_count,worst_boards\n") >= 0;
+
+		for (const CardReport& report: reports) {
+			written = written && fprintf(file, "%s,%u", report.card.c_str(), report.unsolvable) >= 0;
+
+			for (uint32_t count: report.histogram) {
+				written = written && fprintf(file, ",%u", count) >= 0;
+			}
+
+			written = written && fprintf(file, ",%d,%.4f,%u,", report.maxDistance, report.meanDistance, report.worstCount) >= 0;
+
+			for (std::size_t i = 0; i < report.worstBoards.size(); i++) {
+				written = written && fprintf(file, (i == 0)? "%lu" : " %lu", (unsigned long)report.worstBoards[i]) >= 0;
+			}
+
+			written = written && fputc('\n', file) != EOF;
+		}
+
+		return (fclose(file) == 0) && written;
+	}
+
+	/**
+	 * @brief Store reports in a compact binary file
+	 *
+	 * @param 	reports The reports to store
+	 * @param 	path 	The file to write
+	 * @return 			`true` if the file was written, `false` otherwise or if any report has an `overflow`
+	 *
+	 * @note 			The file holds a header followed by one fixed-size record per report. Every field is written
+	 * 					in native byte order. Mean lengths aren't stored, since they follow from the histogram.
+	 */
+	bool writeBinary(const std::vector<CardReport>& reports, const std::string& path) {
+		if (overflows(reports)) {
+			return false;
+		}
+
+		FILE* file = fopen(path.c_str(), "wb");
+		if (!file) {
+			return false;
+		}
+
+		__detail::__report_header header;
+		memcpy(header.magic, __detail::REPORT_MAGIC, sizeof(header.magic));
+		header.version = __detail::REPORT_VERSION;
+		header.count = reports.size();
+		header.maxDistance = MAX_DISTANCE;
+		header.maxWorst = MAX_WORST;
+
+		bool written = fwrite(&header, sizeof(header), 1, file) == 1;
+
+		for (const CardReport& report: reports) {
+			__detail::__report_record record = {};
+			report.card.copy(record.card, __detail::CARD_ID_SIZE - 1);
+			std::copy(report.histogram.begin(), report.histogram.end(), record.histogram);
+			std::copy(report.worstBoards.begin(), report.worstBoards.end(), record.worstBoards);
+
+			record.unsolvable = report.unsolvable;
+			record.maxDistance = report.maxDistance;
+			record.worstCount = report.worstCount;
+
+			written = written && fwrite(&record, sizeof(record), 1, file) == 1;
+		}
+
+		return (fclose(file) == 0) && written;
+	}
+}
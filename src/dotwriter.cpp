@@ -0,0 +1,177 @@
+//
+// FILENAME: dotwriter.cpp | Shifting Stones Search
+// DESCRIPTION: Stream Graphviz DOT code for the search tree and state graph
+// CREATED: 2026-10-22 @ 4:40 PM
+//
+
+#include "dotwriter.hpp"
+
+#include <cmath>
+#include <cinttypes>
+
+#include "boardstates.h"
+
+namespace dotwriter {
+	/**
+	 * @brief Open a DOT file and write the graph header
+	 *
+	 * @param 	path 		The file to write
+	 * @param 	directed 	Write a `digraph` instead of a `graph`
+	 */
+	DotWriter::DotWriter(const std::string& path, bool directed):
+		file(fopen(path.c_str(), "w")),
+		directed(directed),
+		buffer(std::make_unique<char[]>(BUFFER_SIZE))
+	{
+		if (file) {
+			setvbuf(file, buffer.get(), _IOFBF, BUFFER_SIZE);
+			failed = fputs(directed? "digraph G {\n" : "graph G {\n", file) == EOF;
+		}
+	}
+
+	DotWriter::~DotWriter() {
+		close();
+	}
+
+	/**
+	 * @brief Format a board as a 3x3 grid of tile bits
+	 *
+	 * @param 	board 	The board to format
+	 * @return 			The label, valid until the next call
+	 */
+	const char* DotWriter::formatLabel(board_t board) {
+		char* out = label;
+
+		for (int tile = 0; tile < 9; tile++) {
+			for (int bit = 2; bit >= 0; bit--) {
+				*out++ = '0' + ((board >> (24 - BOARD_LEN * tile + bit)) & 1);
+			}
+
+			if (tile == 8) {
+				break;
+			}
+
+			// Tiles are separated by spaces, and rows by an escaped newline
+			if (tile % 3 == 2) {
+				*out++ = '\\';
+				*out++ = 'n';
+			} else {
+				*out++ = ' ';
+			}
+		}
+
+		*out = '\0';
+		return label;
+	}
+
+	/**
+	 * @brief Write a node
+	 *
+	 * @param 	id 		The node's ID
+	 * @param 	board 	The board shown in the node
+	 */
+	void DotWriter::node(uint64_t id, board_t board) {
+		if (good() && fprintf(file, "%" PRIu64 " [label=\"%s\"];\n", id, formatLabel(board)) < 0) {
+			failed = true;
+		}
+	}
+
+	/**
+	 * @brief Write an edge
+	 *
+	 * @param 	from 	The ID of the first node
+	 * @param 	to 		The ID of the second node
+	 * @param 	move 	The move the edge stands for, shown as its label, or 0 for no label
+	 */
+	void DotWriter::edge(uint64_t from, uint64_t to, int move) {
+		if (!good()) {
+			return;
+		}
+
+		const char* CONNECTOR = directed? "->" : "--";
+		const int WRITTEN = move
+			? fprintf(file, "%" PRIu64 "%s%" PRIu64 " [label=\"%d\"];\n", from, CONNECTOR, to, move)
+			: fprintf(file, "%" PRIu64 "%s%" PRIu64 ";\n", from, CONNECTOR, to);
+
+		failed |= WRITTEN < 0;
+	}
+
+	/**
+	 * @brief Write the closing brace and close the file
+	 *
+	 * @return 	`true` if the whole graph was written, `false` otherwise
+	 */
+	bool DotWriter::close() {
+		if (!file) {
+			return false;
+		}
+
+		failed |= fputs("}\n", file) == EOF;
+		failed |= fclose(file) != 0;
+		file = nullptr;
+
+		return !failed;
+	}
+
+	/**
+	 * @brief Stream a tree buffer built by `treeutils::buildTree` as a DOT graph
+	 *
+	 * @param 	tree 	The tree buffer
+	 * @param 	path 	The file to write
+	 * @param 	height 	The deepest level to write
+	 * @return 			`true` if the graph was written, `false` otherwise
+	 *
+	 * @note 			Node IDs are tree buffer indices, and each edge is labeled with the move that made the child.
+	 * 					Empty slots left by pruned boards are skipped.
+	 */
+	bool writeTree(const tree_t tree, const std::string& path, int height) {
+		DotWriter writer(path, true);
+		const uint64_t NODES = TREE_NODES_COUNT(CHILDREN_PER_PARENT, height);
+
+		for (uint64_t index = 0; index < NODES && writer.good(); index++) {
+			const board_t BOARD = BOARD_IDX(tree, index);
+			if (BOARD == 0) {
+				continue;
+			}
+
+			writer.node(index, BOARD);
+
+			// The children of node `n` are stored at `21n + 1` through `21n + 21`
+			if (index != 0) {
+				writer.edge((index - 1) / CHILDREN_PER_PARENT, index, (index - 1) % CHILDREN_PER_PARENT + 1);
+			}
+		}
+
+		return writer.close();
+	}
+
+	/**
+	 * @brief Stream the whole state graph as a DOT graph
+	 *
+	 * @param 	table 	A loaded neighbor table
+	 * @param 	path 	The file to write
+	 * @return 			`true` if the graph was written, `false` otherwise
+	 *
+	 * @note 			Node IDs are `BOARD_STATES` indices. Every move is its own inverse, so each pair of states is
+	 * 					written once, labeled with the move between them.
+	 */
+	bool writeStateGraph(const neighbors::NeighborTable& table, const std::string& path) {
+		DotWriter writer(path);
+
+		for (uint32_t index = 0; index < MAX_BOARD_STATES && writer.good(); index++) {
+			writer.node(index, BOARD_STATES[index]);
+		}
+
+		for (uint32_t index = 0; index < MAX_BOARD_STATES && writer.good(); index++) {
+			const uint32_t* row = table.row(index);
+
+			for (std::size_t move = 0; move < POSSIBLE_CONFIGS; move++) {
+				if (row[move] > index) {
+					writer.edge(index, row[move], move + 1);
+				}
+			}
+		}
+
+		return writer.close();
+	}
+}
@@ -0,0 +1,646 @@
+//
+// FILENAME: extsearch.cpp | Shifting Stones Search
+// DESCRIPTION: External-memory breadth-first search over board states
+// CREATED: 2026-10-18 @ 9:12 AM
+//
+
+#include "extsearch.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <queue>
+
+#include "dedup.hpp"
+#include "successstates.hpp"
+#include "treeutils.hpp"
+
+namespace extsearch {
+	namespace __detail {
+		/**
+		 * @brief The smallest buffer a run file is given. It holds several of the largest encoded blocks.
+		 */
+		const std::size_t MIN_IO_BUFFER = 1UL << 12;
+
+		/**
+		 * @brief The files a final merge holds open besides its runs: both stored levels and the new level
+		 */
+		const std::size_t LEVEL_FILES = 3;
+
+		/**
+		 * @brief The smallest memory cap a search can keep to: a two-way merge with the smallest buffers
+		 */
+		const std::size_t MIN_MEMORY = (2 + LEVEL_FILES) * MIN_IO_BUFFER;
+
+		/**
+		 * @brief The name pattern of a search's working directory, completed by `mkdtemp`
+		 */
+		const char* const WORK_DIRECTORY = "extsearch-XXXXXX";
+
+		/**
+		 * @struct __merge_head
+		 * @brief The next unread board of a run taking part in a merge
+		 */
+		struct __merge_head {
+			board_t 	board; 	// The board at the head of the run
+			std::size_t run; 	// The index of the run the board came from
+
+			bool operator>(const __merge_head& other) const {
+				return board > other.board;
+			}
+		};
+
+		/**
+		 * @brief Tracks membership in a sorted run while it is streamed in ascending order
+		 */
+		class __sorted_cursor {
+		public:
+			__sorted_cursor(const std::string& path, std::size_t bufferBytes):
+				reader(path, bufferBytes)
+			{
+				valid = reader.next(head);
+			}
+
+			/**
+			 * @brief Check if a board is in the run
+			 *
+			 * @param 	board 	The board to look for. Must be no smaller than any previously queried board.
+			 * @return 			`true` if the board is in the run, `false` otherwise
+			 */
+			bool contains(board_t board) {
+				while (valid && head < board) {
+					valid = reader.next(head);
+				}
+
+				return valid && head == board;
+			}
+
+			/**
+			 * @brief Check if the run was opened and read without errors
+			 */
+			bool good() const {
+				return reader.good();
+			}
+
+		private:
+			RunReader reader;
+			board_t   head = 0;
+			bool 	  valid = false;
+		};
+
+		/**
+		 * @brief Create a working directory no other search shares
+		 *
+		 * @param 	parent 	The directory to create it in
+		 * @return 			The path of the new directory, or an empty string if it couldn't be created
+		 */
+		std::string makeWorkDirectory(const std::string& parent) {
+			std::error_code error;
+			std::filesystem::create_directories(parent, error);
+
+			std::string pattern = (std::filesystem::path(parent) / WORK_DIRECTORY).string();
+			return mkdtemp(pattern.data())? pattern : "";
+		}
+
+		std::string levelPath(const Options& options, int depth) {
+			return (std::filesystem::path(options.directory) / ("level-" + std::to_string(depth) + ".run")).string();
+		}
+
+		std::string runPath(const Options& options, int depth, std::size_t run) {
+			return (std::filesystem::path(options.directory) / ("spill-" + std::to_string(depth) + "-" + std::to_string(run) + ".run")).string();
+		}
+
+		std::string mergePath(const Options& options, int depth, std::size_t pass, std::size_t run) {
+			return (std::filesystem::path(options.directory) / ("merge-" + std::to_string(depth) + "-" + std::to_string(pass) + "-" + std::to_string(run) + ".run")).string();
+		}
+
+		/**
+		 * @brief Sort a chunk of generated boards and spill it to disk as a run
+		 *
+		 * @param 	chunk 	The buffered boards. The buffer is emptied.
+		 * @param 	path 	The run file to write
+		 * @param 	options The search options
+		 * @return 			`true` if the run was written, `false` otherwise
+		 */
+		bool spillRun(std::vector<board_t>& chunk, const std::string& path, const Options& options) {
+			dedup::sortUnique(chunk);
+
+			RunWriter writer(path, options.ioBuffer);
+			for (board_t board: chunk) {
+				writer.push(board);
+			}
+
+			chunk.clear();
+			writer.close();
+			return writer.good();
+		}
+
+		/**
+		 * @brief Merge sorted runs, dropping duplicates
+		 *
+		 * @param 	runs 	The runs to merge
+		 * @param 	options The search options
+		 * @param 	accept 	Called once for every distinct board, in ascending order. Boards it returns `true` for are
+		 * 					written.
+		 * @param 	writer 	The run the accepted boards are written to
+		 * @return 			`true` if every run was read without errors, `false` otherwise
+		 */
+		template<class Filter>
+		bool mergeRuns(const std::vector<std::string>& runs, const Options& options, Filter&& accept, RunWriter& writer) {
+			std::vector<std::unique_ptr<RunReader>> readers;
+			std::priority_queue<__merge_head, std::vector<__merge_head>, std::greater<__merge_head>> heads;
+
+			for (std::size_t i = 0; i < runs.size(); i++) {
+				readers.push_back(std::make_unique<RunReader>(runs[i], options.ioBuffer));
+
+				if (board_t board; readers.back()->next(board)) {
+					heads.push({board, i});
+				}
+			}
+
+			bool first = true;
+			board_t last = 0;
+
+			while (!heads.empty()) {
+				auto [board, run] = heads.top();
+				heads.pop();
+
+				if (board_t following; readers[run]->next(following)) {
+					heads.push({following, run});
+				}
+
+				if (!first && board == last) {
+					continue;
+				}
+
+				first = false;
+				last = board;
+
+				if (accept(board)) {
+					writer.push(board);
+				}
+			}
+
+			bool good = true;
+			for (const auto& reader: readers) {
+				good = good && reader->good();
+			}
+
+			return good;
+		}
+
+		/**
+		 * @brief Generate the level after `current`
+		 *
+		 * @param 	options 	The search options
+		 * @param 	previous 	The level before `current`, or `nullptr` if `current` is the first level
+		 * @param 	current 	The level to expand
+		 * @param 	visit 		Called once for every board added to the new level, in ascending order
+		 * @param 	failed 		Set if a run or level file couldn't be read or written
+		 * @return 				The new level
+		 *
+		 * @note 				Every move is its own inverse, so the neighbors of `current` can only lie in
+		 * 						`previous`, `current` or the new level. Subtracting the two stored levels
+		 * 						is enough to remove every previously visited board.
+		 */
+		template<class Visitor>
+		LevelInfo expandLevel(const Options& options, const LevelInfo* previous, const LevelInfo& current, Visitor&& visit, bool& failed) {
+			const int DEPTH = current.depth + 1;
+			std::vector<std::string> runs;
+
+			// Stream the current level through the move kernel, spilling sorted runs as the buffer fills
+			{
+				std::vector<board_t> chunk;
+				chunk.reserve(options.chunkSize);
+
+				RunReader reader(current.path, options.ioBuffer);
+				for (board_t board; reader.next(board);) {
+					for (int i = 1; i <= (int)POSSIBLE_CONFIGS; i++) {
+						chunk.push_back(treeutils::__permuteBoard(board, i));
+					}
+
+					if (chunk.size() + POSSIBLE_CONFIGS > options.chunkSize) {
+						runs.push_back(runPath(options, DEPTH, runs.size()));
+						failed |= !spillRun(chunk, runs.back(), options);
+					}
+				}
+
+				if (!chunk.empty()) {
+					runs.push_back(runPath(options, DEPTH, runs.size()));
+					failed |= !spillRun(chunk, runs.back(), options);
+				}
+
+				failed |= !reader.good();
+			}
+
+			// Merge groups of runs until few enough are left to open at once
+			const std::size_t FAN_IN = std::max<std::size_t>(2, options.mergeFanIn);
+
+			for (std::size_t pass = 0; runs.size() > FAN_IN; pass++) {
+				std::vector<std::string> merged;
+
+				for (std::size_t i = 0; i < runs.size(); i += FAN_IN) {
+					const std::vector<std::string> GROUP(runs.begin() + i, runs.begin() + std::min(runs.size(), i + FAN_IN));
+
+					if (GROUP.size() == 1) {
+						merged.push_back(GROUP[0]);
+						continue;
+					}
+
+					merged.push_back(mergePath(options, DEPTH, pass, merged.size()));
+					RunWriter writer(merged.back(), options.ioBuffer);
+
+					failed |= !mergeRuns(GROUP, options, [](board_t) { return true; }, writer);
+					writer.close();
+					failed |= !writer.good();
+
+					for (const auto& run: GROUP) {
+						std::filesystem::remove(run);
+					}
+				}
+
+				runs = std::move(merged);
+			}
+
+			// Merge the remaining runs, dropping anything already stored in the last two levels
+			std::unique_ptr<__sorted_cursor> before = previous? std::make_unique<__sorted_cursor>(previous->path, options.ioBuffer) : nullptr;
+			__sorted_cursor now(current.path, options.ioBuffer);
+
+			LevelInfo next = {DEPTH, 0, levelPath(options, DEPTH)};
+			RunWriter writer(next.path, options.ioBuffer);
+
+			failed |= !mergeRuns(runs, options, [&](board_t board) {
+				if (now.contains(board) || (before && before->contains(board))) {
+					return false;
+				}
+
+				visit(board);
+				return true;
+			}, writer);
+
+			writer.close();
+			next.count = writer.size();
+
+			failed |= !writer.good() || !now.good() || (before && !before->good());
+
+			for (const auto& run: runs) {
+				std::filesystem::remove(run);
+			}
+
+			return next;
+		}
+
+		/**
+		 * @brief Write the sorted, deduplicated start set as level 0
+		 *
+		 * @param 	options The search options
+		 * @param 	start 	The boards making up level 0
+		 * @param 	failed 	Set if the level file couldn't be read or written
+		 * @return 			The stored level
+		 */
+		LevelInfo storeStart(const Options& options, std::vector<board_t> start, bool& failed) {
+			LevelInfo level = {0, 0, levelPath(options, 0)};
+			failed |= !spillRun(start, level.path, options);
+
+			RunReader reader(level.path, options.ioBuffer);
+			for (board_t board; reader.next(board); level.count++);
+
+			failed |= !reader.good();
+			return level;
+		}
+
+		/**
+		 * @brief Walk backwards through the stored levels to recover the moves leading to a board
+		 *
+		 * @param 	levels 	The stored levels, starting at the root
+		 * @param 	board 	A board stored in level `last`
+		 * @param 	last 	The depth of the level holding `board`
+		 * @param 	options The search options
+		 * @return 			The moves from the root to `board`, in the order they are applied
+		 */
+		std::vector<int> tracePath(const std::vector<LevelInfo>& levels, board_t board, int last, const Options& options) {
+			std::vector<int> moves(last);
+
+			for (int depth = last - 1; depth >= 0; depth--) {
+				// Every move is its own inverse, so the parent is one move away from the child
+				std::vector<std::pair<board_t, int>> candidates;
+				for (int i = 1; i <= (int)POSSIBLE_CONFIGS; i++) {
+					candidates.emplace_back(treeutils::__permuteBoard(board, i), i);
+				}
+				std::sort(candidates.begin(), candidates.end());
+
+				__sorted_cursor cursor(levels[depth].path, options.ioBuffer);
+				for (const auto& [parent, move]: candidates) {
+					if (cursor.contains(parent)) {
+						board = parent;
+						moves[depth] = move;
+						break;
+					}
+				}
+			}
+
+			return moves;
+		}
+	}
+
+	/**
+	 * @brief Open a run file for writing
+	 *
+	 * @param 	path 		The file to create
+	 * @param 	bufferBytes The number of encoded bytes buffered between writes
+	 */
+	RunWriter::RunWriter(const std::string& path, std::size_t bufferBytes):
+		file(fopen(path.c_str(), "wb")),
+		bufferBytes(std::max(bufferBytes, __detail::MIN_IO_BUFFER)),
+		failed(!file)
+	{
+		pending.reserve(frontier::BLOCK_SIZE);
+		buffer.reserve(this->bufferBytes / sizeof(uint32_t));
+	}
+
+	RunWriter::~RunWriter() {
+		close();
+	}
+
+	/**
+	 * @brief Append a board to the run
+	 *
+	 * @param 	board 	The board to append. Must be larger than the previously pushed board.
+	 *
+	 * @note 			Boards are stored in the block format of `frontier::encodeBlock`
+	 */
+	void RunWriter::push(board_t board) {
+		pending.push_back(board);
+		count++;
+
+		if (pending.size() == frontier::BLOCK_SIZE) {
+			frontier::encodeBlock(pending.data(), pending.size(), buffer);
+			pending.clear();
+
+			if (buffer.size() * sizeof(uint32_t) >= bufferBytes) {
+				flush();
+			}
+		}
+	}
+
+	/**
+	 * @brief Flush any buffered data and close the file
+	 */
+	void RunWriter::close() {
+		if (file) {
+			if (!pending.empty()) {
+				frontier::encodeBlock(pending.data(), pending.size(), buffer);
+				pending.clear();
+			}
+
+			flush();
+			failed |= fclose(file) != 0;
+			file = nullptr;
+		}
+	}
+
+	void RunWriter::flush() {
+		if (file && !buffer.empty()) {
+			failed |= fwrite(buffer.data(), sizeof(uint32_t), buffer.size(), file) != buffer.size();
+		}
+
+		buffer.clear();
+	}
+
+	/**
+	 * @brief Open a run file for reading
+	 *
+	 * @param 	path 		The file to read
+	 * @param 	bufferBytes The number of bytes read ahead
+	 */
+	RunReader::RunReader(const std::string& path, std::size_t bufferBytes):
+		file(fopen(path.c_str(), "rb")),
+		buffer(std::max(bufferBytes, __detail::MIN_IO_BUFFER) / sizeof(uint32_t)),
+		failed(!file)
+	{}
+
+	RunReader::~RunReader() {
+		if (file) {
+			fclose(file);
+		}
+	}
+
+	/**
+	 * @brief Read the next board in the run
+	 *
+	 * @param 	board 	Set to the next board
+	 * @return 			`true` if a board was read, `false` at the end of the run
+	 */
+	bool RunReader::next(board_t& board) {
+		if (blockPosition == blockLength) {
+			if (!fill(frontier::BLOCK_HEADER) || !fill(frontier::blockWords(buffer[position]))) {
+				return false;
+			}
+
+			blockLength = frontier::decodeBlock(&buffer[position], block);
+			blockPosition = 0;
+			position += frontier::blockWords(buffer[position]);
+		}
+
+		board = block[blockPosition++];
+		return true;
+	}
+
+	/**
+	 * @brief Make sure a number of unread words are buffered
+	 *
+	 * @param 	words 	The number of words needed
+	 * @return 			`true` if the words are available, `false` if the run ended first
+	 */
+	bool RunReader::fill(std::size_t words) {
+		if (length - position >= words) {
+			return true;
+		}
+
+		// Move the unread tail to the front of the buffer and read the next chunk behind it
+		std::copy(buffer.begin() + position, buffer.begin() + length, buffer.begin());
+		length -= position;
+		position = 0;
+
+		if (file) {
+			length += fread(buffer.data() + length, sizeof(uint32_t), buffer.size() - length, file);
+			failed |= ferror(file) != 0;
+		}
+
+		return length >= words;
+	}
+
+	/**
+	 * @brief Write every breadth-first level reachable from a set of boards to disk
+	 *
+	 * @param 	start 	The boards making up level 0
+	 * @param 	options The search options
+	 * @return 			The stored levels, in order of depth, or no levels if a file couldn't be read or written
+	 *
+	 * @note 			The level files are left in a new working directory inside `options.directory` for the
+	 * 					caller to read. The directory is removed again if the exploration fails.
+	 */
+	std::vector<LevelInfo> explore(const std::vector<board_t>& start, const Options& options) {
+		Options local = options;
+		local.directory = __detail::makeWorkDirectory(options.directory);
+
+		if (local.directory.empty()) {
+			return {};
+		}
+
+		bool failed = false;
+		std::vector<LevelInfo> levels = {__detail::storeStart(local, start, failed)};
+
+		while (!failed && levels.back().count != 0 && (options.maxDepth < 0 || levels.back().depth < options.maxDepth)) {
+			const LevelInfo* previous = (levels.size() > 1)? &levels[levels.size() - 2] : nullptr;
+			levels.push_back(__detail::expandLevel(local, previous, levels.back(), [](board_t) {}, failed));
+		}
+
+		if (failed) {
+			std::error_code error;
+			std::filesystem::remove_all(local.directory, error);
+			return {};
+		}
+
+		// The final level is empty
+		if (levels.back().count == 0 && levels.size() > 1) {
+			std::filesystem::remove(levels.back().path);
+			levels.pop_back();
+		}
+
+		return levels;
+	}
+
+	/**
+	 * @brief Find the closest board satisfying a target card, keeping only the frontier in memory
+	 *
+	 * @param 	initialBoard 	The board to start from
+	 * @param 	target 			The ID of the target card
+	 * @param 	options 		The search options
+	 * @return 					The success state and the moves leading to it, or `0` and an empty move set
+	 * 							if no success state was found
+	 */
+	std::tuple<board_t, std::vector<int>> search(board_t initialBoard, const std::string& target, const Options& options) {
+		solver::Solution solution = searchWithin(initialBoard, target, {}, options);
+
+		if (solution.status != solver::Status::Solved) {
+			return std::make_tuple(0, std::vector<int>{});
+		}
+
+		return std::make_tuple(solution.board, solution.moves);
+	}
+
+	/**
+	 * @brief Find the closest board satisfying a target card within a budget, keeping only the frontier in memory
+	 *
+	 * @param 	initialBoard 	The board to start from
+	 * @param 	target 			The ID of the target card
+	 * @param 	budget 			Limits on how much the search may do
+	 * @param 	options 		The search options
+	 * @return 					The solution. If the budget or `options.maxDepth` runs out first, the stored board with
+	 * 							the smallest `success_states::lowerBound` is returned instead, along with the moves
+	 * 							leading to it. The status is `IOError` if a working file couldn't be read or written,
+	 * 							and `Exhausted` without searching if the memory cap is below `__detail::MIN_MEMORY`.
+	 *
+	 * @note 					The budget is checked between levels, so a deadline can be overrun by the time it takes
+	 * 							to expand one level. The memory cap covers the boards buffered before a run is spilled,
+	 * 							the scratch copy they are sorted through, and the buffer of every run file open at once,
+	 * 							so a small cap also lowers the merge fan-in and the buffer sizes.
+	 */
+	solver::Solution searchWithin(board_t initialBoard, const std::string& target, const solver::Budget& budget, const Options& options) {
+		solver::Solution solution;
+
+		const int ESTIMATE = success_states::lowerBound(initialBoard, target);
+		if (ESTIMATE == -1) {
+			return solution;
+		}
+
+		// A cap too small for a two-way merge can't store a level, but the start may already satisfy the card
+		if (budget.maxMemory && budget.maxMemory < __detail::MIN_MEMORY) {
+			solution.status = (ESTIMATE == 0)? solver::Status::Solved : solver::Status::Exhausted;
+			solution.board = initialBoard;
+			solution.optimal = ESTIMATE == 0;
+			solution.lowerBound = ESTIMATE;
+			return solution;
+		}
+
+		Options bounded = options;
+		if (const std::size_t MEMORY = budget.maxMemory; MEMORY) {
+			// Merging holds the most files open. Spilling holds one reader and one writer beside the chunk and the
+			// radix sort's scratch copy of it.
+			const std::size_t FILES = MEMORY / __detail::MIN_IO_BUFFER; // The files that fit with the smallest buffers
+			bounded.mergeFanIn = std::clamp<std::size_t>(FILES - __detail::LEVEL_FILES, 2, std::max<std::size_t>(2, options.mergeFanIn));
+			bounded.ioBuffer = std::clamp(MEMORY / (bounded.mergeFanIn + __detail::LEVEL_FILES), __detail::MIN_IO_BUFFER, std::max(options.ioBuffer, __detail::MIN_IO_BUFFER));
+
+			const std::size_t SPILL_BUFFERS = 2 * bounded.ioBuffer;
+			bounded.chunkSize = std::min(options.chunkSize, (MEMORY - SPILL_BUFFERS) / (2 * sizeof(board_t)));
+		}
+
+		bounded.directory = __detail::makeWorkDirectory(options.directory);
+		if (bounded.directory.empty()) {
+			solution.status = solver::Status::IOError;
+			return solution;
+		}
+
+		bool failed = false;
+		std::vector<LevelInfo> levels = {__detail::storeStart(bounded, {initialBoard}, failed)};
+		board_t best = initialBoard;
+		int bestEstimate = ESTIMATE, bestDepth = 0;
+		std::size_t nodes = 1;
+
+		solution.status = (bestEstimate == 0)? solver::Status::Solved : solver::Status::Unsolvable;
+
+		while (!failed && solution.status == solver::Status::Unsolvable && levels.back().count != 0) {
+			if ((options.maxDepth >= 0 && levels.back().depth >= options.maxDepth)
+				|| (budget.maxDepth >= 0 && levels.back().depth >= budget.maxDepth)) {
+				solution.status = solver::Status::Exhausted;
+			} else if (budget.maxNodes && nodes >= budget.maxNodes) {
+				solution.status = solver::Status::Exhausted;
+			} else if (budget.stop.stop_requested()) {
+				solution.status = solver::Status::Cancelled;
+			} else if (solver::clock_type::now() >= budget.deadline) {
+				solution.status = solver::Status::TimedOut;
+			}
+
+			if (solution.status != solver::Status::Unsolvable) {
+				break;
+			}
+
+			const LevelInfo* previous = (levels.size() > 1)? &levels[levels.size() - 2] : nullptr;
+			levels.push_back(__detail::expandLevel(bounded, previous, levels.back(), [&](board_t board) {
+				if (const int ESTIMATE = success_states::lowerBound(board, target); ESTIMATE < bestEstimate) {
+					best = board;
+					bestEstimate = ESTIMATE;
+					bestDepth = levels.back().depth + 1;
+				}
+			}, failed));
+
+			nodes += levels.back().count;
+
+			if (bestEstimate == 0) {
+				solution.status = solver::Status::Solved;
+			}
+		}
+
+		// A level cut short by a failed read or write says nothing about the boards it's missing
+		if (failed) {
+			solution.status = solver::Status::IOError;
+		}
+		else if (solution.status != solver::Status::Unsolvable) {
+			solution.board = best;
+			solution.moves = __detail::tracePath(levels, best, bestDepth, bounded);
+			solution.optimal = solution.status == solver::Status::Solved;
+
+			// Every stored level was checked without finding a success state
+			solution.lowerBound = solution.optimal? bestDepth : std::max<int>(levels.back().depth + 1, ESTIMATE);
+		}
+
+		if (!options.keepLevels || failed) {
+			std::error_code error;
+			std::filesystem::remove_all(bounded.directory, error);
+		}
+
+		return solution;
+	}
+}
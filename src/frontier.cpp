@@ -0,0 +1,242 @@
+//
+// FILENAME: frontier.cpp | Shifting Stones Search
+// DESCRIPTION: A compressed container for sorted sets of boards
+// CREATED: 2026-10-18 @ 1:26 PM
+//
+
+#include "frontier.hpp"
+
+#include <algorithm>
+#include <bit>
+
+namespace frontier {
+	/**
+	 * @brief Encode up to `BLOCK_SIZE` sorted boards as a single block
+	 *
+	 * @param 	boards 	The boards to encode, in ascending order
+	 * @param 	count 	The number of boards (1 - `BLOCK_SIZE`)
+	 * @param 	out 	The buffer to append the block to
+	 * @return 			The number of words appended
+	 *
+	 * @note
+	 * Block layout:
+	 * 	- Word 0: the number of boards (bits 0 - 7) and the delta bit width (bits 8 - 12)
+	 * 	- Word 1: the first board in the block
+	 * 	- The deltas between neighboring boards, packed at the stored width. Delta `i` is stored in lane
+	 * 	  `i % BLOCK_LANES`, and the words of the lanes are interleaved.
+	 */
+	std::size_t encodeBlock(const board_t* boards, std::size_t count, std::vector<uint32_t>& out) {
+		board_t largest = 0;
+		for (std::size_t i = 1; i < count; i++) {
+			largest |= boards[i] - boards[i - 1];
+		}
+
+		const uint32_t WIDTH = std::bit_width(largest);
+		const std::size_t START = out.size();
+
+		out.push_back((uint32_t)count | WIDTH << 8);
+		out.push_back(boards[0]);
+		out.resize(START + BLOCK_HEADER + BLOCK_LANES * WIDTH, 0);
+
+		uint32_t* payload = &out[START + BLOCK_HEADER];
+
+		for (std::size_t i = 1; i < count; i++) {
+			const uint32_t DELTA = boards[i] - boards[i - 1];
+			const std::size_t LANE = i % BLOCK_LANES;
+			const std::size_t BIT = (i / BLOCK_LANES) * WIDTH;
+			const std::size_t WORD = BIT / 32, OFFSET = BIT % 32;
+
+			payload[BLOCK_LANES * WORD + LANE] |= DELTA << OFFSET;
+
+			// The delta straddles two words of the lane
+			if (OFFSET + WIDTH > 32) {
+				payload[BLOCK_LANES * (WORD + 1) + LANE] |= DELTA >> (32 - OFFSET);
+			}
+		}
+
+		return out.size() - START;
+	}
+
+	/**
+	 * @brief Decode a block written by `encodeBlock`
+	 *
+	 * @param 	in 		A pointer to the start of the block
+	 * @param 	boards 	A buffer of at least `BLOCK_SIZE` boards to decode into
+	 * @return 			The number of boards decoded
+	 *
+	 * @note 			Every lane is unpacked with the same shifts, so the inner loop has no data-dependent
+	 * 					control flow and the compiler turns it into vector shifts and masks
+	 */
+	std::size_t decodeBlock(const uint32_t* in, board_t* boards) {
+		const std::size_t COUNT = in[0] & 0xFF;
+		const uint32_t WIDTH = (in[0] >> 8) & 0x1F;
+		const uint32_t MASK = (1U << WIDTH) - 1;
+		const uint32_t* payload = in + BLOCK_HEADER;
+
+		uint32_t deltas[BLOCK_SIZE] = {};
+
+		if (WIDTH != 0) {
+			for (std::size_t group = 0; group < BLOCK_SIZE / BLOCK_LANES; group++) {
+				const std::size_t BIT = group * WIDTH;
+				const std::size_t WORD = BIT / 32, OFFSET = BIT % 32;
+				const bool STRADDLES = OFFSET + WIDTH > 32;
+
+				for (std::size_t lane = 0; lane < BLOCK_LANES; lane++) {
+					uint32_t delta = payload[BLOCK_LANES * WORD + lane] >> OFFSET;
+
+					if (STRADDLES) {
+						delta |= payload[BLOCK_LANES * (WORD + 1) + lane] << (32 - OFFSET);
+					}
+
+					deltas[BLOCK_LANES * group + lane] = delta & MASK;
+				}
+			}
+		}
+
+		boards[0] = in[1];
+		for (std::size_t i = 1; i < COUNT; i++) {
+			boards[i] = boards[i - 1] + deltas[i];
+		}
+
+		return COUNT;
+	}
+
+	/**
+	 * @brief Get the total number of words in a block from its header
+	 *
+	 * @param 	header 	The first word of the block
+	 * @return 			The size of the block in words
+	 */
+	std::size_t blockWords(uint32_t header) {
+		return BLOCK_HEADER + BLOCK_LANES * ((header >> 8) & 0x1F);
+	}
+
+	/**
+	 * @brief Add a board to the frontier
+	 *
+	 * @param 	board 	The board to add. Must be larger than the previously added board.
+	 */
+	void CompressedFrontier::push(board_t board) {
+		pending.push_back(board);
+		count++;
+
+		if (pending.size() == BLOCK_SIZE) {
+			finish();
+		}
+	}
+
+	/**
+	 * @brief Encode any boards waiting for a full block
+	 *
+	 * @note  Blocks are self-contained, so boards can still be pushed afterwards
+	 */
+	void CompressedFrontier::finish() {
+		if (!pending.empty()) {
+			encodeBlock(pending.data(), pending.size(), words);
+			pending.clear();
+		}
+	}
+
+	/**
+	 * @brief Remove every board and release the encoded blocks
+	 */
+	void CompressedFrontier::clear() {
+		std::vector<uint32_t>().swap(words);
+		pending.clear();
+		count = 0;
+	}
+
+	/**
+	 * @brief Store the frontier in a binary file
+	 *
+	 * @param 	file 	The file to write to
+	 * @return 			`true` if the frontier was written, `false` otherwise
+	 *
+	 * @note 			`finish` must be called first if any boards are pending
+	 */
+	bool CompressedFrontier::write(FILE* file) const {
+		const uint64_t HEADER[] = {count, words.size()};
+
+		return pending.empty()
+			&& fwrite(HEADER, sizeof(HEADER), 1, file) == 1
+			&& fwrite(words.data(), sizeof(uint32_t), words.size(), file) == words.size();
+	}
+
+	/**
+	 * @brief Load a frontier stored with `CompressedFrontier::write`
+	 *
+	 * @param 	file 	The file to read from
+	 * @return 			`true` if the frontier was read, `false` otherwise
+	 */
+	bool CompressedFrontier::read(FILE* file) {
+		uint64_t header[2];
+		clear();
+
+		if (fread(header, sizeof(header), 1, file) != 1) {
+			return false;
+		}
+
+		words.resize(header[1]);
+		count = header[0];
+
+		return fread(words.data(), sizeof(uint32_t), words.size(), file) == words.size();
+	}
+
+	/**
+	 * @brief Start reading a frontier from its smallest board
+	 *
+	 * @param 	frontier 	The frontier to read
+	 */
+	CompressedFrontier::Cursor::Cursor(const CompressedFrontier& frontier):
+		frontier(frontier)
+	{}
+
+	/**
+	 * @brief Read the next board in the frontier
+	 *
+	 * @param 	board 	Set to the next board
+	 * @return 			`true` if a board was read, `false` at the end of the frontier
+	 */
+	bool CompressedFrontier::Cursor::next(board_t& board) {
+		if (position == length) {
+			if (word < frontier.words.size()) {
+				length = decodeBlock(&frontier.words[word], block);
+				word += blockWords(frontier.words[word]);
+			}
+			else if (word == frontier.words.size() && !frontier.pending.empty()) {
+				length = frontier.pending.size();
+				std::copy(frontier.pending.begin(), frontier.pending.end(), block);
+				word++;
+			}
+			else {
+				return false;
+			}
+
+			position = 0;
+		}
+
+		board = block[position++];
+		return true;
+	}
+
+	/**
+	 * @brief Check if a board is in the frontier
+	 *
+	 * @param 	board 	The board to look for. Must be no smaller than any previously queried board.
+	 * @return 			`true` if the board is in the frontier, `false` otherwise
+	 *
+	 * @note 			Lookups share the cursor position with `next`, so the two should not be mixed
+	 */
+	bool CompressedFrontier::Cursor::contains(board_t board) {
+		if (!started) {
+			valid = next(head);
+			started = true;
+		}
+
+		while (valid && head < board) {
+			valid = next(head);
+		}
+
+		return valid && head == board;
+	}
+}
@@ -0,0 +1,332 @@
+//
+// FILENAME: game.cpp | Shifting Stones Search
+// DESCRIPTION: Two-player game-tree search with alpha-beta pruning
+// CREATED: 2026-10-24 @ 11:30 AM
+//
+
+#include "game.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include "boardstates.h"
+#include "successstates.hpp"
+#include "treeutils.hpp"
+
+namespace game {
+	namespace __detail {
+		/**
+		 * @brief The number of positions searched between checks of the stop token and deadline
+		 */
+		const std::size_t CHECK_INTERVAL = 4096;
+
+		/**
+		 * @brief The transposition table card index of player 0's positions. Player 1 uses the next index.
+		 *
+		 * @note  Card indices run from 0 to 125 and the table stores 7 bits, so the two indices above them never
+		 * 		  collide with entries written by the single-player solvers
+		 */
+		const int KEY_BASE = 126;
+
+		/**
+		 * @brief Scores at least this large (or at most its negative) come from a completed card
+		 *
+		 * @note  Heuristic scores are clamped below it
+		 */
+		const int WIN_BOUND = WIN - MAX_PLY;
+
+		/**
+		 * @brief A score outside every real score
+		 */
+		const int INFINITE = WIN + 1;
+
+		/**
+		 * @brief Convert a score from the searching ply to the position itself before storing it
+		 *
+		 * @note  Scores from completed cards count moves from the root, but the table is shared by every path to the
+		 * 		  position, so they are stored as counting moves from the position
+		 */
+		inline int toTable(int score, int ply) {
+			return (score >= WIN_BOUND)? score + ply : (score <= -WIN_BOUND)? score - ply : score;
+		}
+
+		inline int fromTable(int score, int ply) {
+			return (score >= WIN_BOUND)? score - ply : (score <= -WIN_BOUND)? score + ply : score;
+		}
+	}
+
+	/**
+	 * @brief Construct a new `Engine` object
+	 *
+	 * @param 	table 			A loaded neighbor table
+	 * @param 	hands 			The cards each player is trying to complete
+	 * @param 	transpositions 	An optional table shared with other engines. Its game entries depend on the hands, so
+	 * 							it should be cleared before searching with different ones.
+	 */
+	Engine::Engine(const neighbors::NeighborTable& table, const Hands& hands, transposition::TranspositionTable* transpositions):
+		table(table),
+		owned(transpositions? nullptr : std::make_unique<transposition::TranspositionTable>(DEFAULT_TABLE_MB)),
+		transpositions(transpositions? transpositions : owned.get())
+	{
+		setHand(0, hands[0]);
+		setHand(1, hands[1]);
+	}
+
+	/**
+	 * @brief Change the cards a player is trying to complete
+	 *
+	 * @param 	player 	The player (0 or 1)
+	 * @param 	hand 	The IDs of the player's cards
+	 *
+	 * @note 			One backward search from the success states of every card in the hand gives the player's
+	 * 					distance from every state. An engine that owns its table clears it, since the scores in it
+	 * 					no longer hold.
+	 */
+	void Engine::setHand(int player, const std::vector<std::string>& hand) {
+		std::vector<uint32_t> goals;
+
+		for (const std::string& card: hand) {
+			std::vector<uint32_t> cardGoals = success_states::goalStates(card);
+			goals.insert(goals.end(), cardGoals.begin(), cardGoals.end());
+		}
+
+		std::sort(goals.begin(), goals.end());
+		goals.erase(std::unique(goals.begin(), goals.end()), goals.end());
+
+		distance[player] = neighbors::distances(table, goals);
+
+		if (owned) {
+			owned->clear();
+		}
+	}
+
+	/**
+	 * @brief Score a position without searching it
+	 *
+	 * @param 	board 	The board
+	 * @param 	player 	The player to move
+	 * @return 			How many moves closer the player is to their nearest card than the opponent is to theirs,
+	 * 					or 0 if the board isn't valid
+	 */
+	int Engine::evaluate(board_t board, int player) const {
+		int state = treeutils::isValidBoardState(board);
+
+		return (state == -1)? 0 : heuristic(state, player);
+	}
+
+	/**
+	 * @brief Score a state by the difference between the players' distances, clamped below the score of a win
+	 */
+	int Engine::heuristic(uint32_t state, int player) const {
+		return std::clamp((int)distance[1 - player][state] - (int)distance[player][state], 1 - __detail::WIN_BOUND, __detail::WIN_BOUND - 1);
+	}
+
+	/**
+	 * @brief Find the best move for a player with iterative deepening
+	 *
+	 * @param 	board 	The board
+	 * @param 	player 	The player to move
+	 * @param 	budget 	Limits on how much the search may do. `maxDepth` limits the number of moves looked ahead, and
+	 * 					`maxMemory` doesn't apply. Without a deadline or depth limit the search runs to `MAX_PLY`.
+	 * @return 			The result of the deepest completed iteration. If the budget runs out during the first one,
+	 * 					the move is the best found so far.
+	 *
+	 * @note 			Each iteration searches the previous iteration's best line first, then the move stored in the
+	 * 					transposition table, then the moves that bring the player closest to their cards. The search
+	 * 					ends early once a card is completed by either player within the depth searched.
+	 */
+	Result Engine::search(board_t board, int player, const solver::Budget& budget) {
+		Result result;
+		int root = treeutils::isValidBoardState(board);
+
+		if (root == -1) {
+			return result;
+		}
+
+		this->budget = budget;
+		nodes = 0;
+		stopped = false;
+		previousPV.clear();
+		transpositions->newSearch();
+
+		const int MAX_DEPTH = (budget.maxDepth >= 0)? std::min(budget.maxDepth, MAX_PLY) : MAX_PLY;
+		result.status = solver::Status::Solved;
+
+		for (int depth = 1; depth <= MAX_DEPTH; depth++) {
+			followingPV = true;
+			const int SCORE = negamax(root, player, depth, 0, -__detail::INFINITE, __detail::INFINITE);
+
+			if (stopped) {
+				result.status = stopReason;
+
+				if (result.depth == 0 && pvLength[0] > 0) {
+					result.move = pv[0][0];
+					result.pv = {result.move};
+				}
+
+				break;
+			}
+
+			result.depth = depth;
+			result.score = SCORE;
+			result.pv.assign(pv[0].begin(), pv[0].begin() + pvLength[0]);
+			result.move = result.pv.empty()? 0 : result.pv[0];
+			previousPV = result.pv;
+
+			// A completed card within the depth is the fastest win or the slowest loss, which deeper searches can't
+			// change. A game already over has no move to search.
+			if (std::abs(SCORE) >= __detail::WIN_BOUND) {
+				break;
+			}
+		}
+
+		result.nodes = nodes;
+		return result;
+	}
+
+	/**
+	 * @brief Search a position with alpha-beta pruning
+	 *
+	 * @param 	state 	The `BOARD_STATES` index of the board
+	 * @param 	player 	The player to move
+	 * @param 	depth 	The number of moves left to look ahead
+	 * @param 	ply 	The number of moves made since the root
+	 * @param 	alpha 	The score the player is already guaranteed
+	 * @param 	beta 	The score the opponent is already guaranteed, negated
+	 * @return 			The score for the player to move
+	 */
+	int Engine::negamax(uint32_t state, int player, int depth, int ply, int alpha, int beta) {
+		const int OPPONENT = 1 - player;
+		pvLength[ply] = ply;
+		nodes++;
+
+		if (budget.maxNodes && nodes >= budget.maxNodes) {
+			stopReason = solver::Status::Exhausted;
+			stopped = true;
+		}
+		else if (nodes % __detail::CHECK_INTERVAL == 0 && outOfBudget()) {
+			stopped = true;
+		}
+
+		if (stopped) {
+			return 0;
+		}
+
+		// The opponent made the last move, so they claim their card first
+		if (distance[OPPONENT][state] == 0) {
+			return -(WIN - ply);
+		}
+
+		if (distance[player][state] == 0) {
+			return WIN - ply;
+		}
+
+		if (depth == 0 || ply == MAX_PLY) {
+			return heuristic(state, player);
+		}
+
+		const board_t BOARD = BOARD_STATES[state];
+		const int KEY = __detail::KEY_BASE + player;
+		const int ALPHA = alpha;
+		int storedMove = 0;
+
+		if (transposition::Entry entry; transpositions->probe(BOARD, KEY, entry)) {
+			const int VALUE = __detail::fromTable(entry.value, ply);
+			storedMove = entry.move;
+
+			// The root always searches, so it has a line to report
+			if (ply > 0 && entry.depth >= depth) {
+				if (entry.bound == transposition::Bound::Exact
+					|| (entry.bound == transposition::Bound::Lower && VALUE >= beta)
+					|| (entry.bound == transposition::Bound::Upper && VALUE <= alpha)) {
+					return VALUE;
+				}
+			}
+		}
+
+		const int PV_MOVE = (followingPV && ply < (int)previousPV.size())? previousPV[ply] : 0;
+
+		// Order the moves by key: the previous best line, the stored move, then the player's distance after the move
+		// with the opponent's distance breaking ties
+		std::array<std::pair<int, int>, POSSIBLE_CONFIGS> moves;
+		std::size_t count = 0;
+
+		for (int move = 1; move <= (int)POSSIBLE_CONFIGS; move++) {
+			const uint32_t NEXT = table.neighbor(state, move);
+
+			// Swapping two identical tiles doesn't change the board, so it isn't a real move
+			if (NEXT == state) {
+				continue;
+			}
+
+			const int ORDER = (move == PV_MOVE)? -2 : (move == storedMove)? -1 : (int)distance[player][NEXT] * 256 - distance[OPPONENT][NEXT];
+			moves[count++] = {ORDER, move};
+		}
+
+		std::sort(moves.begin(), moves.begin() + count);
+
+		int best = -__detail::INFINITE;
+		int bestMove = 0;
+
+		for (std::size_t i = 0; i < count; i++) {
+			const int MOVE = moves[i].second;
+
+			followingPV = followingPV && MOVE == PV_MOVE;
+			const int SCORE = -negamax(table.neighbor(state, MOVE), OPPONENT, depth - 1, ply + 1, -beta, -alpha);
+			followingPV = false;
+
+			if (stopped) {
+				// The root keeps the best move found so far, in case no iteration completes
+				if (ply == 0 && bestMove) {
+					pv[0][0] = bestMove;
+					pvLength[0] = 1;
+				}
+
+				return 0;
+			}
+
+			if (SCORE > best) {
+				best = SCORE;
+				bestMove = MOVE;
+			}
+
+			if (SCORE > alpha) {
+				alpha = SCORE;
+
+				pv[ply][ply] = MOVE;
+				std::copy(pv[ply + 1].begin() + ply + 1, pv[ply + 1].begin() + pvLength[ply + 1], pv[ply].begin() + ply + 1);
+				pvLength[ply] = pvLength[ply + 1];
+			}
+
+			if (alpha >= beta) {
+				break;
+			}
+		}
+
+		const transposition::Bound BOUND = (best <= ALPHA)? transposition::Bound::Upper
+			: (best >= beta)? transposition::Bound::Lower
+			: transposition::Bound::Exact;
+
+		transpositions->store(BOARD, KEY, __detail::toTable(best, ply), BOUND, bestMove, depth);
+		return best;
+	}
+
+	/**
+	 * @brief Check the stop token and deadline, recording which one ended the search
+	 *
+	 * @return `true` if the search has to stop, `false` otherwise
+	 */
+	bool Engine::outOfBudget() {
+		if (budget.stop.stop_requested()) {
+			stopReason = solver::Status::Cancelled;
+			return true;
+		}
+
+		if (solver::clock_type::now() >= budget.deadline) {
+			stopReason = solver::Status::TimedOut;
+			return true;
+		}
+
+		return false;
+	}
+}
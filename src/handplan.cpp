@@ -0,0 +1,187 @@
+//
+// FILENAME: handplan.cpp | Shifting Stones Search
+// DESCRIPTION: Plan the cheapest order to complete a hand of cards
+// CREATED: 2026-10-24 @ 9:20 AM
+//
+
+#include "handplan.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include "boardstates.h"
+#include "successstates.hpp"
+#include "treeutils.hpp"
+
+namespace handplan {
+	namespace __detail {
+		/**
+		 * @brief The card recorded for the starting board, which completes nothing
+		 */
+		const uint8_t NO_CARD = 0xFF;
+
+		/**
+		 * @struct __entry
+		 * @brief The cheapest known way to finish a set of cards on one board
+		 */
+		struct __entry {
+			uint32_t state; // The `BOARD_STATES` index of the board
+			uint16_t cost; 	// The total cost of completing the set and ending on the board
+			uint8_t  card; 	// The position in the hand of the card completed last
+		};
+
+		/**
+		 * @brief Sort the entries of a set by state, keeping only the cheapest entry of each
+		 *
+		 * @param 	entries The entries to merge
+		 */
+		void __merge(std::vector<__entry>& entries) {
+			std::sort(entries.begin(), entries.end(), [](const __entry& a, const __entry& b) {
+				return (a.state != b.state)? a.state < b.state : a.cost < b.cost;
+			});
+
+			entries.erase(std::unique(entries.begin(), entries.end(), [](const __entry& a, const __entry& b) {
+				return a.state == b.state;
+			}), entries.end());
+		}
+
+		/**
+		 * @brief Turn the entries of a set into the sources of a search
+		 *
+		 * @param 	entries The entries of the set
+		 * @return 			Each entry's state, starting at the entry's cost
+		 */
+		std::vector<std::pair<uint32_t, int>> __sources(const std::vector<__entry>& entries) {
+			std::vector<std::pair<uint32_t, int>> sources;
+			sources.reserve(entries.size());
+
+			for (const __entry& entry: entries) {
+				sources.emplace_back(entry.state, entry.cost);
+			}
+
+			return sources;
+		}
+	}
+
+	/**
+	 * @brief Find the order and boards that complete a hand of cards for the lowest total cost
+	 *
+	 * @param 	table 	A loaded neighbor table
+	 * @param 	board 	The starting board
+	 * @param 	hand 	The IDs of the cards to complete. There can be at most `MAX_HAND_SIZE`.
+	 * @param 	costs 	The cost of each move. Unit costs give the fewest total moves.
+	 * @param 	budget 	Limits on how much the planner may do. Only the stop token and deadline apply, and they are
+	 * 					checked between searches.
+	 * @return 			The plan, or an empty plan if the board, the hand, or the budget doesn't allow one
+	 *
+	 * @note 			A card is completed on one of its success states, and the next card starts from there. For
+	 * 					each set of completed cards the planner keeps the cheapest cost of ending on every success
+	 * 					state of the last card. One multi-source search from all of those states, each starting at its
+	 * 					cost, then extends the set by every remaining card at once. That takes `2^n` searches for a
+	 * 					hand of `n` cards instead of one per ordering and intermediate board.
+	 */
+	Plan plan(const neighbors::NeighborTable& table, board_t board, const std::vector<std::string>& hand, const weighted::MoveCosts& costs, const solver::Budget& budget) {
+		Plan result;
+		int root = treeutils::isValidBoardState(board);
+
+		if (root == -1 || hand.empty() || hand.size() > (std::size_t)MAX_HAND_SIZE) {
+			return result;
+		}
+
+		std::vector<std::vector<uint32_t>> goals;
+		for (const std::string& card: hand) {
+			goals.push_back(success_states::goalStates(card));
+
+			if (goals.back().empty()) {
+				return result;
+			}
+		}
+
+		const int CARDS = hand.size();
+		const uint32_t FULL = (1U << CARDS) - 1;
+
+		// The entries of each set of completed cards, indexed by a mask of their positions in the hand. Adding a card
+		// always makes the mask larger, so every set is complete by the time the loop reaches it.
+		std::vector<std::vector<__detail::__entry>> reached(FULL + 1);
+		reached[0] = {{(uint32_t)root, 0, __detail::NO_CARD}};
+
+		for (uint32_t subset = 0; subset < FULL; subset++) {
+			__detail::__merge(reached[subset]);
+
+			if (reached[subset].empty()) {
+				continue;
+			}
+
+			if (budget.stop.stop_requested()) {
+				result.status = solver::Status::Cancelled;
+				return result;
+			}
+
+			if (solver::clock_type::now() >= budget.deadline) {
+				result.status = solver::Status::TimedOut;
+				return result;
+			}
+
+			const std::vector<uint16_t> COST = weighted::distances(table, __detail::__sources(reached[subset]), costs);
+
+			for (int card = 0; card < CARDS; card++) {
+				if (subset & (1U << card)) {
+					continue;
+				}
+
+				std::vector<__detail::__entry>& next = reached[subset | (1U << card)];
+
+				for (uint32_t goal: goals[card]) {
+					if (COST[goal] != weighted::UNREACHED) {
+						next.push_back({goal, COST[goal], (uint8_t)card});
+					}
+				}
+			}
+		}
+
+		__detail::__merge(reached[FULL]);
+
+		if (reached[FULL].empty()) {
+			return result;
+		}
+
+		__detail::__entry entry = *std::min_element(reached[FULL].begin(), reached[FULL].end(), [](const __detail::__entry& a, const __detail::__entry& b) {
+			return a.cost < b.cost;
+		});
+
+		result.cost = entry.cost;
+
+		// Walk back through the sets, repeating the search that completed each card to recover its moves
+		for (uint32_t subset = FULL; subset != 0;) {
+			const uint32_t PREVIOUS = subset & ~(1U << entry.card);
+			std::vector<uint8_t> reachedBy;
+			weighted::distances(table, __detail::__sources(reached[PREVIOUS]), costs, &reachedBy);
+
+			Step step;
+			step.card = hand[entry.card];
+			step.board = BOARD_STATES[entry.state];
+
+			uint32_t state = entry.state;
+			for (; reachedBy[state] != weighted::SOURCE_MOVE; state = table.neighbor(state, reachedBy[state])) {
+				step.moves.push_back(reachedBy[state]);
+			}
+
+			std::reverse(step.moves.begin(), step.moves.end());
+
+			// The walk ends on the board the step started from, which is an entry of the previous set
+			auto start = std::lower_bound(reached[PREVIOUS].begin(), reached[PREVIOUS].end(), state, [](const __detail::__entry& a, uint32_t state) {
+				return a.state < state;
+			});
+
+			step.cost = entry.cost - start->cost;
+			result.steps.push_back(std::move(step));
+
+			entry = *start;
+			subset = PREVIOUS;
+		}
+
+		std::reverse(result.steps.begin(), result.steps.end());
+		result.status = solver::Status::Solved;
+		return result;
+	}
+}
@@ -0,0 +1,220 @@
+//
+// FILENAME: idastar.cpp | Shifting Stones Search
+// DESCRIPTION: Iterative deepening A* search backed by a shared transposition table
+// CREATED: 2026-10-21 @ 4:05 PM
+//
+
+#include "idastar.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <vector>
+
+#include "successstates.hpp"
+#include "treeutils.hpp"
+
+namespace idastar {
+	namespace __detail {
+		/**
+		 * @brief The number of nodes visited between checks of the stop token and deadline
+		 */
+		const std::size_t CHECK_INTERVAL = 4096;
+
+		/**
+		 * @brief Returned by `__ida_search::search` when a success state was reached
+		 */
+		const int FOUND = -1;
+
+		/**
+		 * @brief Returned by `__ida_search::search` when the budget ran out
+		 */
+		const int STOPPED = -2;
+
+		/**
+		 * @struct __ida_search
+		 * @brief The state of one query's iterations
+		 */
+		struct __ida_search {
+			const std::vector<std::string>& 	states; 		// The success states of the target card
+			int 								card; 			// The index of the target card
+			const solver::Budget& 				budget;
+			transposition::TranspositionTable* 	transpositions;
+
+			int 			 threshold = 0;
+			std::size_t 	 nodes = 0;
+			solver::Status 	 reason = solver::Status::Solved; 	// Why the search stopped early
+			std::vector<int> path = {}; 						// The moves from the root to the current board
+
+			board_t 		 bestBoard = 0; 					// The board that looked closest to the goal
+			int 			 bestEstimate = INT_MAX;
+			std::vector<int> bestPath = {};
+
+			int search(board_t board, int depth, int undo, int undoEstimate);
+			bool outOfBudget();
+		};
+
+		/**
+		 * @brief Check the budget
+		 *
+		 * @return 	`true` if the search must stop, with `reason` set, `false` otherwise
+		 */
+		bool __ida_search::outOfBudget() {
+			if (budget.maxNodes && nodes > budget.maxNodes) {
+				reason = solver::Status::Exhausted;
+			} else if (nodes % CHECK_INTERVAL == 0 && budget.stop.stop_requested()) {
+				reason = solver::Status::Cancelled;
+			} else if (nodes % CHECK_INTERVAL == 0 && solver::clock_type::now() >= budget.deadline) {
+				reason = solver::Status::TimedOut;
+			}
+
+			return reason != solver::Status::Solved;
+		}
+
+		/**
+		 * @brief Search below a board up to the current threshold
+		 *
+		 * @param 	board 			The board to search from
+		 * @param 	depth 			The number of moves from the root to `board`
+		 * @param 	undo 			The move that led to `board`, which isn't tried again, or 0 at the root
+		 * @param 	undoEstimate 	The estimate of the board `undo` leads back to
+		 * @return 					`FOUND`, `STOPPED`, or the smallest estimated solution length that exceeded the
+		 * 							threshold
+		 *
+		 * @note 					Exact distances are stored along a solution and proven lower bounds for every board
+		 * 							whose subtree failed, so later iterations and other queries skip work already done
+		 */
+		int __ida_search::search(board_t board, int depth, int undo, int undoEstimate) {
+			nodes++;
+			if (outOfBudget()) {
+				return STOPPED;
+			}
+
+			const int ESTIMATE = success_states::lowerBound(board, states);
+			int estimate = ESTIMATE, hint = 0;
+
+			if (transposition::Entry entry; transpositions && transpositions->probe(board, card, entry)
+				&& (entry.bound == transposition::Bound::Exact || entry.bound == transposition::Bound::Lower)) {
+				estimate = std::max(estimate, entry.value);
+				hint = entry.move;
+			}
+
+			if (estimate < bestEstimate) {
+				bestBoard = board;
+				bestEstimate = estimate;
+				bestPath = path;
+			}
+
+			if (depth + estimate > threshold) {
+				return depth + estimate;
+			}
+
+			if (ESTIMATE == 0) {
+				return FOUND;
+			}
+
+			int lowest = INT_MAX, lowestMove = 0;
+
+			// Try the stored best move first
+			for (int i = 0; i <= (int)POSSIBLE_CONFIGS; i++) {
+				const int MOVE = (i == 0)? hint : i;
+				if (MOVE == 0 || MOVE == undo || (i != 0 && MOVE == hint)) {
+					continue;
+				}
+
+				path.push_back(MOVE);
+				const int RESULT = search(treeutils::__permuteBoard(board, MOVE), depth + 1, MOVE, estimate);
+
+				if (RESULT == FOUND) {
+					// The path is left holding the solution. It is optimal, so every board on it is exactly as far from
+					// the goal as the rest of the path.
+					if (transpositions) {
+						transpositions->store(board, card, path.size() - depth, transposition::Bound::Exact, MOVE, threshold - depth);
+					}
+
+					return FOUND;
+				}
+
+				path.pop_back();
+
+				if (RESULT == STOPPED) {
+					return STOPPED;
+				}
+
+				if (RESULT < lowest) {
+					lowest = RESULT;
+					lowestMove = MOVE;
+				}
+			}
+
+			// Undoing the last move wasn't searched, so the bound only trusts the estimate of the board it leads to
+			if (transpositions) {
+				const int BOUND = std::min(lowest - depth, undo? undoEstimate + 1 : INT8_MAX);
+				transpositions->store(board, card, std::min(BOUND, (int)INT8_MAX), transposition::Bound::Lower, lowestMove, threshold - depth);
+			}
+
+			return lowest;
+		}
+	}
+
+	/**
+	 * @brief Find an optimal solution to a single query with iterative deepening A*
+	 *
+	 * @param 	board 			The starting board
+	 * @param 	target 			The ID of the target card
+	 * @param 	budget 			Limits on how much the search may do. The memory cap doesn't apply, since the search
+	 * 							only keeps the current path.
+	 * @param 	transpositions 	An optional table shared with other searches. Bounds found by earlier iterations and
+	 * 							other queries tighten the estimate and order the moves.
+	 * @param 	lowerBound 		A known lower bound on the solution length, used as the first threshold
+	 * @return 					The solution. If the budget runs out first, the board visited with the smallest
+	 * 							estimate is returned instead, along with the moves leading to it.
+	 *
+	 * @note 					The table's generation is left to the caller, so concurrent queries share entries
+	 */
+	solver::Solution solve(board_t board, const std::string& target, const solver::Budget& budget, transposition::TranspositionTable* transpositions, int lowerBound) {
+		solver::Solution solution;
+		auto card = success_states::SUCCESS_STATES.find(target);
+
+		if (treeutils::isValidBoardState(board) == -1 || card == success_states::SUCCESS_STATES.end()) {
+			return solution;
+		}
+
+		__detail::__ida_search search = {card->second, success_states::cardIndex(target), budget, transpositions};
+		search.threshold = std::max(lowerBound, 0);
+
+		for (int result = 0; search.threshold <= MAX_THRESHOLD; search.threshold = result) {
+			if (budget.maxDepth >= 0 && search.threshold > budget.maxDepth) {
+				solution.status = solver::Status::Exhausted;
+				solution.moves = search.bestPath;
+				break;
+			}
+
+			result = search.search(board, 0, 0, 0);
+
+			if (result == __detail::FOUND) {
+				solution.status = solver::Status::Solved;
+				solution.moves = search.path;
+				solution.optimal = true;
+				break;
+			}
+
+			if (result == __detail::STOPPED) {
+				solution.status = search.reason;
+				solution.moves = search.bestPath;
+				break;
+			}
+		}
+
+		if (solution.status != solver::Status::Unsolvable) {
+			solution.board = board;
+			for (int move: solution.moves) {
+				solution.board = treeutils::__permuteBoard(solution.board, move);
+			}
+
+			// Every threshold below the current one failed
+			solution.lowerBound = search.threshold;
+		}
+
+		return solution;
+	}
+}
@@ -0,0 +1,107 @@
+//
+// FILENAME: incremental.cpp | Shifting Stones Search
+// DESCRIPTION: Re-solve a query cheaply after the board changes by one move
+// CREATED: 2026-10-22 @ 1:50 PM
+//
+
+#include "incremental.hpp"
+
+#include <algorithm>
+
+#include "idastar.hpp"
+#include "treeutils.hpp"
+
+namespace incremental {
+	/**
+	 * @brief Create a solver for a target card
+	 *
+	 * @param 	target 			The ID of the target card
+	 * @param 	transpositions 	An optional table shared with other searches. A private table is allocated without one.
+	 */
+	IncrementalSolver::IncrementalSolver(const std::string& target, transposition::TranspositionTable* transpositions):
+		target(target),
+		owned(transpositions? nullptr : std::make_unique<transposition::TranspositionTable>(DEFAULT_TABLE_MB)),
+		transpositions(transpositions? transpositions : owned.get())
+	{}
+
+	/**
+	 * @brief Solve from a new board, forgetting the previous solution
+	 *
+	 * @param 	board 	The board to solve from
+	 * @param 	budget 	Limits on how much the search may do
+	 * @return 			The solution
+	 */
+	const solver::Solution& IncrementalSolver::reset(board_t board, const solver::Budget& budget) {
+		current = board;
+		latest = idastar::solve(board, target, budget, transpositions);
+		hasSolution = true;
+		reuse = Reuse::Cold;
+
+		return latest;
+	}
+
+	/**
+	 * @brief Solve again after a move is made on the current board
+	 *
+	 * @param 	move 	The move made (1 - 21), by either player
+	 * @param 	budget 	Limits on how much a search may do
+	 * @return 			The solution from the new board
+	 *
+	 * @note 			If the budget runs out during a bounded search, the returned solution still reaches a success
+	 * 					state by undoing the move and following the previous solution. It stays `Solved` but is
+	 * 					marked as not optimal, with the best lower bound found, so the next move can still be
+	 * 					bounded by it instead of starting over.
+	 */
+	const solver::Solution& IncrementalSolver::apply(int move, const solver::Budget& budget) {
+		current = treeutils::__permuteBoard(current, move);
+
+		// The game graph is undirected, so a board that can't reach the goal is still stuck one move later
+		if (hasSolution && latest.status == solver::Status::Unsolvable) {
+			reuse = Reuse::Shifted;
+			return latest;
+		}
+
+		if (!hasSolution || latest.status != solver::Status::Solved) {
+			return reset(current, budget);
+		}
+
+		const int DISTANCE = latest.moves.size();
+
+		// A single move changes the distance to the goal by at most one
+		const int LOWER_BOUND = std::max(latest.lowerBound - 1, 0);
+
+		// The rest of a solution is still a solution, and still optimal if the whole one was
+		if (DISTANCE > 0 && latest.moves.front() == move) {
+			latest.moves.erase(latest.moves.begin());
+			latest.lowerBound = LOWER_BOUND;
+			reuse = Reuse::Shifted;
+
+			return latest;
+		}
+
+		// Undoing the move and following the previous solution takes `DISTANCE + 1` moves
+		std::vector<int> fallback = {move};
+		fallback.insert(fallback.end(), latest.moves.begin(), latest.moves.end());
+
+		solver::Budget bounded = budget;
+		bounded.maxDepth = (budget.maxDepth >= 0)? std::min(budget.maxDepth, DISTANCE) : DISTANCE;
+
+		solver::Solution next = idastar::solve(current, target, bounded, transpositions, LOWER_BOUND);
+		reuse = Reuse::Bounded;
+
+		if (next.status == solver::Status::Solved) {
+			latest = next;
+			return latest;
+		}
+
+		// Running out of depth past `DISTANCE` proves nothing shorter than the fallback exists
+		const bool PROVEN = next.status == solver::Status::Exhausted && next.lowerBound > DISTANCE;
+
+		latest.status = solver::Status::Solved;
+		latest.moves = fallback;
+		latest.optimal = PROVEN;
+		latest.lowerBound = PROVEN? DISTANCE + 1 : std::max(next.lowerBound, LOWER_BOUND);
+
+		return latest;
+	}
+}
@@ -7,69 +7,81 @@
 #include <iostream>
 #include <cstdlib>
 #include <chrono>
-#include <ctime>
 #include <functional>
+#include <random>
 
-#include "faces.h"
+#include "batch.hpp"
+#include "neighbors.hpp"
 #include "treeutils.hpp"
 #include "successstates.hpp"
 #include "treegraph.hpp"
 
+/**
+ * @brief Deal a random starting board
+ * 
+ * @return A valid board
+ * 
+ * @note   The generator is seeded once, so boards dealt in the same second differ
+ */
 board_t generateBoard() {
-	board_t board = 0;
-	srand(time(nullptr));
-
-	// Store the possible tile choices. Flips are pre-calculated.
-	const Faces TILE_CHOICES[] = {
-		(rand() % 2)? Moon : Sun,
-		(rand() % 2)? Bird : Fish,
-		(rand() % 2)? Bird : Fish,
-		(rand() % 2)? Tree : Seed,
-		(rand() % 2)? Tree : Seed,
-		(rand() % 2)? Tree : Seed,
-		(rand() % 2)? Boat : Horse,
-		(rand() % 2)? Boat : Horse,
-		(rand() % 2)? Boat : Horse,
-	};
-
-	//
-	// Storing visited board indices
-	//
-	// Rather than looping over an array of visited incides to help determine if an index can
-	// be used or not, visited board indices can be stored in a bit field. Every time an index
-	// is chosed to be loaded into the board, or "visited", a 1 gets loaded into the bit
-	// corresponding to the index of the tile in the array. This way, we can check if an index
-	// was visited by masking out the bit at any given index and seeing if it's set or not.
-	//
-	// The visited bit field is stored in 16 bits, but only the first 9 bits are used.
-	//
-
-	const size_t NUM_TILES = 9;
-	uint16_t visited = 0;
-
-    for (size_t i = 0; i < NUM_TILES; i++)  {
-        uint8_t index;
-		
-		// Pick a new value from the possible tile choices. Each tile can only be chosen once.
-		do {
-			index = rand() % NUM_TILES;
-		} while ((bool)((visited & (1 << index)) >> index)); // If the index was already used, choose another
-
-		// Mark the index as visited
-		visited |= 1 << index;
-
-		//
-		// Load the tile onto the board. Board tiles are stored with tile (0, 0) being at the highest
-		// place values (bits 24 - 27) and tile (2, 2) being at the lowest place value (bits 1 - 3).
-		// Thus, 
-		//
-		board |= (TILE_CHOICES[index] << (24 - i * 3));
-    }
-
-	return board;
+	static std::mt19937_64 random(std::random_device{}());
+	return treeutils::randomBoard(random);
 }
 
-int main() {
+/**
+ * @brief Answer (board, card) queries read from stdin
+ * 
+ * @return The exit code
+ * 
+ * @note   Each input line holds a board as a decimal integer followed by a card ID. Each output line holds the
+ * 		   optimal number of moves followed by the moves themselves, or `-1` if the query has no solution.
+ */
+int runBatch() {
+	std::vector<board_t> boards;
+	std::vector<int> cards;
+
+	board_t board;
+	std::string card;
+	while (std::cin >> board >> card) {
+		boards.push_back(board);
+		cards.push_back(success_states::cardIndex(card));
+	}
+
+	std::vector<uint8_t> moveCounts(boards.size());
+	std::vector<uint64_t> moveLists(boards.size());
+
+	// Store a freshly built table so later runs can map it instead
+	const neighbors::NeighborTable* table = neighbors::sharedTable();
+	if (!table) {
+		std::cerr << "The neighbor table was already loaded from another file\n";
+		return EXIT_FAILURE;
+	}
+	table->saveIfMissing();
+
+	batch::BatchEngine engine(*table);
+	engine.solve(boards.data(), cards.data(), boards.size(), moveCounts.data(), moveLists.data());
+
+	for (std::size_t i = 0; i < boards.size(); i++) {
+		if (moveCounts[i] == batch::UNSOLVED) {
+			std::cout << "-1\n";
+			continue;
+		}
+
+		std::cout << (int)moveCounts[i];
+		for (int move: batch::decodeMoves(moveLists[i], moveCounts[i])) {
+			std::cout << " " << move;
+		}
+		std::cout << "\n";
+	}
+
+	return 0;
+}
+
+int main(int argc, char** argv) {
+	if (argc > 1 && std::string(argv[1]) == "--batch") {
+		return runBatch();
+	}
+
 	//std::cout << success_states::getID(0b101100111001101110010001100) << "\n";
 
 	board_t board = 0b100100101101011100100011000;//generateBoard();
@@ -0,0 +1,359 @@
+//
+// FILENAME: mcts.cpp | Shifting Stones Search
+// DESCRIPTION: Parallel Monte Carlo tree search for two-player play with hidden hands
+// CREATED: 2026-10-24 @ 2:40 PM
+//
+
+#include "mcts.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <thread>
+
+#include "treeutils.hpp"
+
+namespace mcts {
+	namespace __detail {
+		/**
+		 * @brief The number of playouts a thread runs between checks of the stop token and deadline
+		 */
+		const std::size_t CHECK_INTERVAL = 16;
+
+		/**
+		 * @brief The index `__node_pool::allocate` returns when the pool is full
+		 */
+		const uint32_t NO_NODE = UINT32_MAX;
+
+		/**
+		 * @brief Allocate an empty pool
+		 *
+		 * @param 	capacity 	The number of nodes in the pool
+		 */
+		__node_pool::__node_pool(std::size_t capacity):
+			nodes(std::make_unique<__node[]>(capacity)),
+			capacity(capacity)
+		{}
+
+		/**
+		 * @brief Claim a run of nodes
+		 *
+		 * @param 	count 	The number of nodes
+		 * @return 			The index of the first node, or `NO_NODE` if the pool doesn't have enough left. The nodes
+		 * 					keep whatever values they had, so the caller initializes them.
+		 */
+		uint32_t __node_pool::allocate(uint32_t count) {
+			const std::size_t FIRST = next.fetch_add(count, std::memory_order_relaxed);
+			return (FIRST + count <= capacity)? FIRST : NO_NODE;
+		}
+
+		/**
+		 * @brief Release every node
+		 *
+		 * @note  Must not be called while other threads use the pool
+		 */
+		void __node_pool::reset() {
+			next.store(0, std::memory_order_relaxed);
+		}
+
+		/**
+		 * @brief Get the number of nodes handed out
+		 */
+		std::size_t __node_pool::size() const {
+			return std::min(next.load(std::memory_order_relaxed), capacity);
+		}
+	}
+
+	/**
+	 * @brief Construct a new `Engine` object
+	 *
+	 * @param 	deal 	What the searching player knows about the cards in play
+	 * @param 	options Settings for every search
+	 */
+	Engine::Engine(const Deal& deal, const Options& options):
+		options(options),
+		hiddenCards(deal.hiddenCards),
+		pool(std::max<std::size_t>(options.maxNodes, 1 + POSSIBLE_CONFIGS))
+	{
+		for (const std::string& card: deal.own) {
+			const auto& masks = success_states::goalMasks(card);
+			own.insert(own.end(), masks.begin(), masks.end());
+		}
+
+		for (const std::string& card: deal.opponent) {
+			const auto& masks = success_states::goalMasks(card);
+			opponent.insert(opponent.end(), masks.begin(), masks.end());
+		}
+
+		for (const std::string& card: deal.unseen) {
+			unseen.push_back(success_states::goalMasks(card));
+		}
+	}
+
+	/**
+	 * @brief Find the best move for the searching player
+	 *
+	 * @param 	board 	The board, with the searching player to move
+	 * @param 	budget 	Limits on how much the search may do. `maxNodes` caps the playouts, and `maxDepth` and
+	 * 					`maxMemory` don't apply.
+	 * @return 			The result. If the budget runs out first, the move is the best found so far.
+	 */
+	Result Engine::search(board_t board, const solver::Budget& budget) {
+		Result result;
+
+		if (treeutils::isValidBoardState(board) == -1) {
+			return result;
+		}
+
+		pool.reset();
+		const uint32_t ROOT = pool.allocate(1);
+		__detail::__node& root = pool[ROOT];
+		root.board = board;
+		root.childCount = 0;
+		root.firstChild.store(0, std::memory_order_relaxed);
+		root.visits.store(0, std::memory_order_relaxed);
+		root.value.store(0, std::memory_order_relaxed);
+
+		const std::size_t TARGET = budget.maxNodes? std::min(options.simulations, budget.maxNodes) : options.simulations;
+		const unsigned THREADS = options.threads? options.threads : std::max(1U, std::thread::hardware_concurrency());
+		const uint64_t SEED = options.seed? options.seed : std::random_device()();
+
+		std::atomic<std::size_t> started = 0, finished = 0;
+		std::atomic<bool> stopped = false;
+
+		auto worker = [&](unsigned thread) {
+			std::mt19937_64 random(SEED + thread * 0x9E3779B97F4A7C15ULL);
+			std::vector<uint32_t> path;
+			std::vector<std::size_t> cards(unseen.size());
+			masks_type sampled;
+
+			for (std::size_t count = 0; !stopped.load(std::memory_order_relaxed); count++) {
+				if (count % __detail::CHECK_INTERVAL == 0 && (budget.stop.stop_requested() || solver::clock_type::now() >= budget.deadline)) {
+					stopped.store(true, std::memory_order_relaxed);
+					break;
+				}
+
+				if (started.fetch_add(1, std::memory_order_relaxed) >= TARGET) {
+					break;
+				}
+
+				// Complete the opponent's hand with a random draw from the unseen cards
+				sampled = opponent;
+				std::iota(cards.begin(), cards.end(), 0);
+
+				for (int i = 0; i < hiddenCards && i < (int)cards.size(); i++) {
+					std::swap(cards[i], cards[i + random() % (cards.size() - i)]);
+					sampled.insert(sampled.end(), unseen[cards[i]].begin(), unseen[cards[i]].end());
+				}
+
+				const std::array<const masks_type*, 2> GOALS = {&own, &sampled};
+
+				// Walk down the tree. Player 0 is the searching player, and `points` is their result in half points.
+				uint32_t node = ROOT;
+				int player = 0, points = 0;
+				bool expanded = false;
+				path.clear();
+
+				for (;;) {
+					__detail::__node& current = pool[node];
+					path.push_back(node);
+					current.visits.fetch_add(options.virtualLoss, std::memory_order_relaxed);
+
+					// The other player made the last move, so they claim their card first
+					if (success_states::matchesAny(current.board, *GOALS[1 - player])) {
+						points = (player == 1)? 2 : 0;
+						break;
+					}
+
+					if (success_states::matchesAny(current.board, *GOALS[player])) {
+						points = (player == 0)? 2 : 0;
+						break;
+					}
+
+					uint32_t first = current.firstChild.load(std::memory_order_acquire);
+
+					if (first == 0 && !expanded) {
+						expanded = expand(node);
+						first = current.firstChild.load(std::memory_order_acquire);
+					}
+
+					if (first == 0 || first == EXPANDING) {
+						points = playout(current.board, player, GOALS, random);
+						break;
+					}
+
+					node = select(node);
+					player = 1 - player;
+				}
+
+				// The node at depth `i` was reached by player 0's move when `i` is odd
+				for (std::size_t i = 0; i < path.size(); i++) {
+					__detail::__node& current = pool[path[i]];
+					current.value.fetch_add((i % 2)? points : 2 - points, std::memory_order_relaxed);
+					current.visits.fetch_add(1 - options.virtualLoss, std::memory_order_relaxed);
+				}
+
+				finished.fetch_add(1, std::memory_order_relaxed);
+			}
+		};
+
+		{
+			std::vector<std::jthread> workers;
+			for (unsigned t = 0; t < THREADS; t++) {
+				workers.emplace_back(worker, t);
+			}
+		}
+
+		result.simulations = finished.load();
+		result.nodes = pool.size();
+		result.status = (result.simulations >= TARGET)? solver::Status::Solved
+			: budget.stop.stop_requested()? solver::Status::Cancelled
+			: solver::Status::TimedOut;
+
+		const uint32_t FIRST = root.firstChild.load();
+		uint32_t mostVisits = 0;
+
+		for (uint32_t i = 0; FIRST != 0 && FIRST != EXPANDING && i < root.childCount; i++) {
+			const __detail::__node& child = pool[FIRST + i];
+			const uint32_t VISITS = child.visits.load();
+			result.visits[child.move - 1] = VISITS;
+
+			if (VISITS > mostVisits) {
+				mostVisits = VISITS;
+				result.move = child.move;
+				result.winRate = child.value.load() / (2.0 * VISITS);
+			}
+		}
+
+		return result;
+	}
+
+	/**
+	 * @brief Pick the child of a node with the highest UCT score
+	 *
+	 * @param 	node 	The pool index of an expanded node
+	 * @return 			The pool index of the child. Unvisited children are picked first.
+	 */
+	uint32_t Engine::select(uint32_t node) {
+		__detail::__node& parent = pool[node];
+		const uint32_t FIRST = parent.firstChild.load(std::memory_order_acquire);
+		const double LOG_VISITS = std::log(std::max<uint32_t>(1, parent.visits.load(std::memory_order_relaxed)));
+
+		uint32_t best = FIRST;
+		double bestScore = -1;
+
+		for (uint32_t child = FIRST; child < FIRST + parent.childCount; child++) {
+			const uint32_t VISITS = pool[child].visits.load(std::memory_order_relaxed);
+
+			if (VISITS == 0) {
+				return child;
+			}
+
+			// A child's value is kept for the player who moved into it, which is the player choosing here
+			const double SCORE = pool[child].value.load(std::memory_order_relaxed) / (2.0 * VISITS)
+				+ options.exploration * std::sqrt(LOG_VISITS / VISITS);
+
+			if (SCORE > bestScore) {
+				best = child;
+				bestScore = SCORE;
+			}
+		}
+
+		return best;
+	}
+
+	/**
+	 * @brief Add a child for every move from a node
+	 *
+	 * @param 	node 	The pool index of the node
+	 * @return 			`true` if this thread added the children, `false` if another thread got there first or the
+	 * 					pool is full
+	 *
+	 * @note 			The first thread to swap the first-child index from 0 to `EXPANDING` adds the children, then
+	 * 					publishes them by storing the index. A node left at `EXPANDING` is a leaf from then on.
+	 */
+	bool Engine::expand(uint32_t node) {
+		__detail::__node& parent = pool[node];
+		uint32_t unexpanded = 0;
+
+		if (!parent.firstChild.compare_exchange_strong(unexpanded, EXPANDING, std::memory_order_acq_rel)) {
+			return false;
+		}
+
+		std::array<board_t, POSSIBLE_CONFIGS> boards;
+		std::array<uint8_t, POSSIBLE_CONFIGS> moves;
+		uint32_t count = 0;
+
+		for (int move = 1; move <= (int)POSSIBLE_CONFIGS; move++) {
+			// Swapping two identical tiles doesn't change the board, so it isn't a real move
+			if (board_t next = treeutils::__permuteBoard(parent.board, move); next != parent.board) {
+				boards[count] = next;
+				moves[count++] = move;
+			}
+		}
+
+		const uint32_t FIRST = pool.allocate(count);
+		if (FIRST == __detail::NO_NODE) {
+			return false;
+		}
+
+		for (uint32_t i = 0; i < count; i++) {
+			__detail::__node& child = pool[FIRST + i];
+			child.board = boards[i];
+			child.move = moves[i];
+			child.childCount = 0;
+			child.firstChild.store(0, std::memory_order_relaxed);
+			child.visits.store(0, std::memory_order_relaxed);
+			child.value.store(0, std::memory_order_relaxed);
+		}
+
+		parent.childCount = count;
+		parent.firstChild.store(FIRST, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	 * @brief Play a game out from a position
+	 *
+	 * @param 	board 	The board
+	 * @param 	player 	The player to move
+	 * @param 	goals 	The success states of each player's cards
+	 * @param 	random 	The calling thread's random generator
+	 * @return 			Player 0's result in half points: 2 for a win, 1 for a draw, 0 for a loss
+	 *
+	 * @note 			Each turn the mover takes a move that completes one of their cards if there is one, and
+	 * 					otherwise a random move. A game still going after `playoutDepth` moves goes to the player
+	 * 					with the smaller distance estimate.
+	 */
+	int Engine::playout(board_t board, int player, const std::array<const masks_type*, 2>& goals, std::mt19937_64& random) const {
+		for (int depth = 0; depth < options.playoutDepth; depth++) {
+			if (success_states::matchesAny(board, *goals[1 - player])) {
+				return (player == 1)? 2 : 0;
+			}
+
+			if (success_states::matchesAny(board, *goals[player])) {
+				return (player == 0)? 2 : 0;
+			}
+
+			board_t next = board;
+
+			for (int move = 1; move <= (int)POSSIBLE_CONFIGS; move++) {
+				if (board_t candidate = treeutils::__permuteBoard(board, move); success_states::matchesAny(candidate, *goals[player])) {
+					return (player == 0)? 2 : 0;
+				}
+			}
+
+			while (next == board) {
+				next = treeutils::__permuteBoard(board, random() % POSSIBLE_CONFIGS + 1);
+			}
+
+			board = next;
+			player = 1 - player;
+		}
+
+		const int OWN = success_states::lowerBound(board, *goals[0]);
+		const int OPPONENT = success_states::lowerBound(board, *goals[1]);
+
+		return (OWN < OPPONENT)? 2 : (OWN > OPPONENT)? 0 : 1;
+	}
+}
@@ -0,0 +1,210 @@
+//
+// FILENAME: msbfs.cpp | Shifting Stones Search
+// DESCRIPTION: Multi-source bit-parallel breadth-first search for distance statistics
+// CREATED: 2026-10-19 @ 3:30 PM
+//
+
+#include "msbfs.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <numeric>
+#include <thread>
+
+namespace msbfs {
+	namespace __detail {
+		/**
+		 * @struct __lanes
+		 * @brief The three lane arrays a batch searches with, reused across batches
+		 *
+		 * @note  A finished batch leaves `visit` and `visitNext` empty, so only `seen` is cleared before the next one
+		 */
+		struct __lanes {
+			std::vector<uint64_t> seen = std::vector<uint64_t>(MAX_BOARD_STATES, 0);
+			std::vector<uint64_t> visit = std::vector<uint64_t>(MAX_BOARD_STATES, 0);
+			std::vector<uint64_t> visitNext = std::vector<uint64_t>(MAX_BOARD_STATES, 0);
+		};
+
+		/**
+		 * @brief Search from up to 64 sources at once with lane arrays left by an earlier batch
+		 *
+		 * @param 	table 	A loaded neighbor table
+		 * @param 	sources The state indices to search from
+		 * @param 	count 	The number of sources (1 - `BATCH_SIZE`)
+		 * @param 	lanes 	The lane arrays to search with
+		 * @return 			The statistics for the sources
+		 */
+		Statistics __batch(const neighbors::NeighborTable& table, const uint32_t* sources, std::size_t count, __lanes& lanes) {
+			auto& [seen, visit, visitNext] = lanes;
+			std::fill(seen.begin(), seen.end(), 0);
+
+			Statistics stats;
+
+			stats.sources.assign(sources, sources + count);
+			stats.eccentricity.assign(count, 0);
+			stats.histogram.assign(1, 0);
+
+			for (std::size_t i = 0; i < count; i++) {
+				seen[sources[i]] |= 1ULL << i;
+				visit[sources[i]] |= 1ULL << i;
+				stats.histogram[0]++;
+			}
+
+			for (uint8_t depth = 1; ; depth++) {
+				// Spread every source's frontier to its neighbors
+				for (std::size_t state = 0; state < MAX_BOARD_STATES; state++) {
+					if (visit[state] == 0) {
+						continue;
+					}
+
+					const uint32_t* row = table.row(state);
+					for (std::size_t move = 0; move < POSSIBLE_CONFIGS; move++) {
+						visitNext[row[move]] |= visit[state];
+					}
+				}
+
+				// Keep only the sources reaching each state for the first time
+				uint64_t reached = 0, pairs = 0;
+
+				for (std::size_t state = 0; state < MAX_BOARD_STATES; state++) {
+					uint64_t fresh = visitNext[state] & ~seen[state];
+
+					seen[state] |= fresh;
+					visit[state] = fresh;
+					visitNext[state] = 0;
+
+					reached |= fresh;
+					pairs += std::popcount(fresh);
+				}
+
+				if (reached == 0) {
+					break;
+				}
+
+				stats.histogram.push_back(pairs);
+
+				for (; reached != 0; reached &= reached - 1) {
+					stats.eccentricity[std::countr_zero(reached)] = depth;
+				}
+			}
+
+			stats.diameter = *std::max_element(stats.eccentricity.begin(), stats.eccentricity.end());
+			stats.radius = *std::min_element(stats.eccentricity.begin(), stats.eccentricity.end());
+
+			return stats;
+		}
+	}
+
+	/**
+	 * @brief Combine the statistics of another set of sources into this one
+	 *
+	 * @param 	other 	The statistics to add
+	 */
+	void Statistics::merge(const Statistics& other) {
+		if (other.sources.empty()) {
+			return;
+		}
+
+		diameter = sources.empty()? other.diameter : std::max(diameter, other.diameter);
+		radius = sources.empty()? other.radius : std::min(radius, other.radius);
+
+		sources.insert(sources.end(), other.sources.begin(), other.sources.end());
+		eccentricity.insert(eccentricity.end(), other.eccentricity.begin(), other.eccentricity.end());
+
+		histogram.resize(std::max(histogram.size(), other.histogram.size()), 0);
+		for (std::size_t i = 0; i < other.histogram.size(); i++) {
+			histogram[i] += other.histogram[i];
+		}
+	}
+
+	/**
+	 * @brief Get the average distance over every (source, state) pair
+	 */
+	double Statistics::meanDistance() const {
+		uint64_t pairs = 0, total = 0;
+
+		for (std::size_t i = 0; i < histogram.size(); i++) {
+			pairs += histogram[i];
+			total += i * histogram[i];
+		}
+
+		return pairs? (double)total / pairs : 0.0;
+	}
+
+	/**
+	 * @brief Search from up to 64 sources at once
+	 *
+	 * @param 	table 	A loaded neighbor table
+	 * @param 	sources The state indices to search from
+	 * @param 	count 	The number of sources (1 - `BATCH_SIZE`)
+	 * @return 			The statistics for the sources
+	 *
+	 * @note
+	 * Each state holds a 64-bit lane per array, one bit per source. `seen` marks the sources that have reached a
+	 * state, and `visit` marks the sources whose frontier holds it. A single scan of a state's row spreads every
+	 * source's frontier at once, so the neighbor reads shared by overlapping searches are paid for only once.
+	 */
+	Statistics batch(const neighbors::NeighborTable& table, const uint32_t* sources, std::size_t count) {
+		__detail::__lanes lanes;
+		return __detail::__batch(table, sources, count, lanes);
+	}
+
+	/**
+	 * @brief Gather distance statistics from any number of sources
+	 *
+	 * @param 	table 	A loaded neighbor table
+	 * @param 	sources The state indices to search from
+	 * @param 	threads The number of threads to use, or 0 for one per hardware thread
+	 * @return 			The combined statistics, with per-source results in the order of `sources`
+	 *
+	 * @note 			Sources are split into batches of 64, and each thread works through batches on its own
+	 * 					three lane arrays (~62 MB per thread)
+	 */
+	Statistics fromSources(const neighbors::NeighborTable& table, const std::vector<uint32_t>& sources, unsigned threads) {
+		const std::size_t BATCHES = (sources.size() + BATCH_SIZE - 1) / BATCH_SIZE;
+		threads = threads? threads : std::max(1U, std::thread::hardware_concurrency());
+
+		std::vector<Statistics> results(BATCHES);
+		std::atomic<std::size_t> nextBatch = 0;
+
+		auto work = [&]() {
+			__detail::__lanes lanes;
+
+			for (std::size_t i = nextBatch++; i < BATCHES; i = nextBatch++) {
+				const std::size_t COUNT = std::min(BATCH_SIZE, sources.size() - i * BATCH_SIZE);
+				results[i] = __detail::__batch(table, &sources[i * BATCH_SIZE], COUNT, lanes);
+			}
+		};
+
+		{
+			std::vector<std::jthread> workers;
+			for (unsigned t = 1; t < std::min<std::size_t>(threads, BATCHES); t++) {
+				workers.emplace_back(work);
+			}
+
+			work();
+		}
+
+		Statistics stats;
+		for (const auto& result: results) {
+			stats.merge(result);
+		}
+
+		return stats;
+	}
+
+	/**
+	 * @brief Gather distance statistics from every valid board in `BOARD_STATES`
+	 *
+	 * @param 	table 	A loaded neighbor table
+	 * @param 	threads The number of threads to use, or 0 for one per hardware thread
+	 * @return 			The statistics for the whole state graph
+	 */
+	Statistics allStates(const neighbors::NeighborTable& table, unsigned threads) {
+		std::vector<uint32_t> sources(MAX_BOARD_STATES);
+		std::iota(sources.begin(), sources.end(), 0);
+
+		return fromSources(table, sources, threads);
+	}
+}
@@ -0,0 +1,241 @@
+//
+// FILENAME: neighbors.cpp | Shifting Stones Search
+// DESCRIPTION: A precomputed table of neighboring board states
+// CREATED: 2026-10-19 @ 8:40 AM
+//
+
+#include "neighbors.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "treeutils.hpp"
+
+namespace neighbors {
+	namespace __detail {
+		/**
+		 * @struct __table_header
+		 * @brief The header written in front of a stored neighbor table
+		 */
+		struct __table_header {
+			uint32_t magic; 	// Always `TABLE_MAGIC`
+			uint32_t version; 	// The layout version of the file
+			uint32_t states; 	// The number of rows in the table
+			uint32_t moves; 	// The number of columns in the table
+		};
+
+		const uint32_t TABLE_MAGIC = 0x4E425353; // "SSBN"
+		const uint32_t TABLE_VERSION = 1;
+	}
+
+	/**
+	 * @brief Find the index of a neighboring state without a table
+	 *
+	 * @param 	index 	The index of the starting state
+	 * @param 	move 	The move to apply (1 - 21)
+	 * @return 			The index of the resulting state
+	 */
+	uint32_t computeNeighbor(uint32_t index, int move) {
+		return treeutils::isValidBoardState(treeutils::__permuteBoard(BOARD_STATES[index], move));
+	}
+
+	NeighborTable::~NeighborTable() {
+		release();
+	}
+
+	/**
+	 * @brief Build the table in memory
+	 *
+	 * @note  Rows are split evenly across the available hardware threads
+	 */
+	void NeighborTable::build() {
+		release();
+		owned.resize(MAX_BOARD_STATES * POSSIBLE_CONFIGS);
+
+		const unsigned THREADS = std::max(1U, std::thread::hardware_concurrency());
+		const std::size_t SLICE = (MAX_BOARD_STATES + THREADS - 1) / THREADS;
+		std::vector<std::jthread> workers;
+
+		for (unsigned t = 0; t < THREADS; t++) {
+			workers.emplace_back([this, t, SLICE]() {
+				const std::size_t END = std::min<std::size_t>(MAX_BOARD_STATES, (t + 1) * SLICE);
+
+				for (std::size_t i = t * SLICE; i < END; i++) {
+					for (int move = 1; move <= (int)POSSIBLE_CONFIGS; move++) {
+						owned[POSSIBLE_CONFIGS * i + move - 1] = computeNeighbor(i, move);
+					}
+				}
+			});
+		}
+
+		workers.clear(); // Join every worker
+		data = owned.data();
+	}
+
+	/**
+	 * @brief Map a stored table into memory
+	 *
+	 * @param 	path 	The file to load
+	 * @return 			`true` if the table was loaded, `false` if the file is missing or doesn't hold a table
+	 *
+	 * @note 				The file is mapped read-only, so pages are loaded on first use and shared between
+	 * 						every process using the same file
+	 */
+	bool NeighborTable::load(const std::string& path) {
+		release();
+
+		int fd = open(path.c_str(), O_RDONLY);
+		if (fd == -1) {
+			return false;
+		}
+
+		struct stat info;
+		const std::size_t EXPECTED = sizeof(__detail::__table_header) + MAX_BOARD_STATES * POSSIBLE_CONFIGS * sizeof(uint32_t);
+
+		if (fstat(fd, &info) == -1 || (std::size_t)info.st_size != EXPECTED) {
+			close(fd);
+			return false;
+		}
+
+		void* file = mmap(nullptr, EXPECTED, PROT_READ, MAP_SHARED, fd, 0);
+		close(fd);
+
+		if (file == MAP_FAILED) {
+			return false;
+		}
+
+		const auto* header = (const __detail::__table_header*)file;
+		if (header->magic != __detail::TABLE_MAGIC || header->version != __detail::TABLE_VERSION
+			|| header->states != MAX_BOARD_STATES || header->moves != POSSIBLE_CONFIGS) {
+			munmap(file, EXPECTED);
+			return false;
+		}
+
+		mapping = file;
+		mappedBytes = EXPECTED;
+		data = (const uint32_t*)(header + 1);
+
+		return true;
+	}
+
+	/**
+	 * @brief Store the table in a file that can be mapped by `NeighborTable::load`
+	 *
+	 * @param 	path 	The file to write
+	 * @return 			`true` if the table was written, `false` otherwise
+	 */
+	bool NeighborTable::save(const std::string& path) const {
+		if (!data) {
+			return false;
+		}
+
+		FILE* file = fopen(path.c_str(), "wb");
+		if (!file) {
+			return false;
+		}
+
+		const __detail::__table_header HEADER = {__detail::TABLE_MAGIC, __detail::TABLE_VERSION, MAX_BOARD_STATES, POSSIBLE_CONFIGS};
+		const std::size_t ENTRIES = MAX_BOARD_STATES * POSSIBLE_CONFIGS;
+
+		bool written = fwrite(&HEADER, sizeof(HEADER), 1, file) == 1
+			&& fwrite(data, sizeof(uint32_t), ENTRIES, file) == ENTRIES;
+
+		return (fclose(file) == 0) && written;
+	}
+
+	/**
+	 * @brief Store a table built in memory so later runs can map it instead
+	 *
+	 * @param 	path 	The file to write
+	 * @return 			`true` if the table is mapped, the file already exists, or the table was written
+	 *
+	 * @note 			An existing file is never replaced, since other processes may have it mapped
+	 */
+	bool NeighborTable::saveIfMissing(const std::string& path) const {
+		return mapped() || std::filesystem::exists(path) || save(path);
+	}
+
+	/**
+	 * @brief Free or unmap the table
+	 */
+	void NeighborTable::release() {
+		if (mapping) {
+			munmap(mapping, mappedBytes);
+			mapping = nullptr;
+			mappedBytes = 0;
+		}
+
+		std::vector<uint32_t>().swap(owned);
+		data = nullptr;
+	}
+
+	/**
+	 * @brief Get the process-wide neighbor table
+	 *
+	 * @param 	path 	The file to map the table from
+	 * @return 			The shared table, or `nullptr` if it was already loaded for a different path
+	 *
+	 * @note 			The table is loaded on first use. If the file is missing or holds a different table, the table
+	 * 					is built in memory instead and nothing is written; callers that want later runs to map it
+	 * 					can call `NeighborTable::saveIfMissing`.
+	 */
+	const NeighborTable* sharedTable(const std::string& path) {
+		static NeighborTable table;
+		static std::string loadedPath;
+		static std::once_flag loaded;
+
+		std::call_once(loaded, [&]() {
+			loadedPath = path;
+
+			if (!table.load(path)) {
+				table.build();
+			}
+		});
+
+		return (path == loadedPath)? &table : nullptr;
+	}
+
+	/**
+	 * @brief Find the distance from a set of states to every other state
+	 *
+	 * @param 	table 	A loaded neighbor table
+	 * @param 	sources The indices of the states at distance 0
+	 * @return 			The distance to every state index, or `UNREACHED`
+	 *
+	 * @note 			The search runs entirely on state indices, so each expansion is a single row read
+	 */
+	std::vector<uint8_t> distances(const NeighborTable& table, const std::vector<uint32_t>& sources) {
+		std::vector<uint8_t> distance(MAX_BOARD_STATES, UNREACHED);
+		std::vector<uint32_t> queue;
+		queue.reserve(MAX_BOARD_STATES);
+
+		for (uint32_t source: sources) {
+			if (distance[source] == UNREACHED) {
+				distance[source] = 0;
+				queue.push_back(source);
+			}
+		}
+
+		for (std::size_t i = 0; i < queue.size(); i++) {
+			const uint32_t* row = table.row(queue[i]);
+			const uint8_t NEXT = distance[queue[i]] + 1;
+
+			for (std::size_t move = 0; move < POSSIBLE_CONFIGS; move++) {
+				if (distance[row[move]] == UNREACHED) {
+					distance[row[move]] = NEXT;
+					queue.push_back(row[move]);
+				}
+			}
+		}
+
+		return distance;
+	}
+}
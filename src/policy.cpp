@@ -0,0 +1,221 @@
+//
+// FILENAME: policy.cpp | Shifting Stones Search
+// DESCRIPTION: Precomputed optimal moves from every state toward a target card
+// CREATED: 2026-10-20 @ 11:45 AM
+//
+
+#include "policy.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstdio>
+#include <filesystem>
+#include <thread>
+
+#include "successstates.hpp"
+#include "treeutils.hpp"
+
+namespace policy {
+	namespace __detail {
+		/**
+		 * @brief The card ID length stored in a policy file header
+		 */
+		const std::size_t CARD_ID_SIZE = 12;
+
+		/**
+		 * @struct __policy_header
+		 * @brief The header written in front of a stored policy table
+		 */
+		struct __policy_header {
+			char 	 card[CARD_ID_SIZE]; 	// The null-terminated card ID
+			uint32_t states; 				// The number of entries in the table
+		};
+	}
+
+	/**
+	 * @brief Build the table for a target card
+	 *
+	 * @param 	table 	A loaded neighbor table
+	 * @param 	target 	The ID of the target card
+	 * @param 	threads The number of threads used to fill in the move masks, or 0 for one per hardware thread
+	 *
+	 * @note 			Distances come from a single backward search from every success state. Every move is its
+	 * 					own inverse, so the distance from a state to the goal set is its distance from the goal set.
+	 * 					A move is optimal when it leads to a state exactly one move closer.
+	 */
+	void PolicyTable::build(const neighbors::NeighborTable& table, const std::string& target, unsigned threads) {
+		threads = threads? threads : std::max(1U, std::thread::hardware_concurrency());
+
+		const std::vector<uint8_t> distances = neighbors::distances(table, success_states::goalStates(target));
+		const std::size_t SLICE = (MAX_BOARD_STATES + threads - 1) / threads;
+
+		card = target;
+		entries.assign(MAX_BOARD_STATES, 0);
+
+		std::vector<std::jthread> workers;
+		for (unsigned t = 0; t < threads; t++) {
+			workers.emplace_back([&, t]() {
+				const std::size_t END = std::min<std::size_t>(MAX_BOARD_STATES, (t + 1) * SLICE);
+
+				for (std::size_t state = t * SLICE; state < END; state++) {
+					const uint8_t DISTANCE = distances[state];
+					const uint32_t* row = table.row(state);
+					uint32_t moves = 0;
+
+					for (std::size_t move = 0; move < POSSIBLE_CONFIGS && DISTANCE != 0 && DISTANCE != UNSOLVABLE; move++) {
+						if (distances[row[move]] + 1 == DISTANCE) {
+							moves |= 1U << move;
+						}
+					}
+
+					entries[state] = moves | (uint32_t)DISTANCE << DISTANCE_SHIFT;
+				}
+			});
+		}
+	}
+
+	/**
+	 * @brief Load a table stored with `PolicyTable::save`
+	 *
+	 * @param 	path 	The file to read
+	 * @return 			`true` if the table was read, `false` otherwise
+	 */
+	bool PolicyTable::load(const std::string& path) {
+		FILE* file = fopen(path.c_str(), "rb");
+		if (!file) {
+			return false;
+		}
+
+		__detail::__policy_header header;
+		bool read = fread(&header, sizeof(header), 1, file) == 1 && header.states == MAX_BOARD_STATES;
+
+		if (read) {
+			header.card[__detail::CARD_ID_SIZE - 1] = '\0';
+			card = header.card;
+			entries.resize(header.states);
+			read = fread(entries.data(), sizeof(uint32_t), entries.size(), file) == entries.size();
+		}
+
+		fclose(file);
+
+		if (!read) {
+			entries.clear();
+			card.clear();
+		}
+
+		return read;
+	}
+
+	/**
+	 * @brief Store the table in a binary file
+	 *
+	 * @param 	path 	The file to write
+	 * @return 			`true` if the table was written, `false` otherwise
+	 */
+	bool PolicyTable::save(const std::string& path) const {
+		FILE* file = fopen(path.c_str(), "wb");
+		if (!file) {
+			return false;
+		}
+
+		__detail::__policy_header header = {};
+		card.copy(header.card, __detail::CARD_ID_SIZE - 1);
+		header.states = entries.size();
+
+		bool written = fwrite(&header, sizeof(header), 1, file) == 1
+			&& fwrite(entries.data(), sizeof(uint32_t), entries.size(), file) == entries.size();
+
+		return (fclose(file) == 0) && written;
+	}
+
+	/**
+	 * @brief Get a single optimal move from a state
+	 *
+	 * @param 	index 	The `BOARD_STATES` index of the state
+	 * @return 			The lowest-numbered optimal move (1 - 21), or 0 if the state is a success state or unsolvable
+	 */
+	int PolicyTable::bestMove(uint32_t index) const {
+		const uint32_t MOVES = optimalMoves(index);
+		return MOVES? std::countr_zero(MOVES) + 1 : 0;
+	}
+
+	/**
+	 * @brief List every optimal move from a board
+	 *
+	 * @param 	board 	The board to move from
+	 * @return 			The optimal moves (1 - 21) in ascending order, or an empty list if there are none
+	 */
+	std::vector<int> PolicyTable::optimalMoveList(board_t board) const {
+		std::vector<int> moves;
+		int index = treeutils::isValidBoardState(board);
+
+		if (index == -1) {
+			return moves;
+		}
+
+		for (uint32_t mask = optimalMoves(index); mask != 0; mask &= mask - 1) {
+			moves.push_back(std::countr_zero(mask) + 1);
+		}
+
+		return moves;
+	}
+
+	/**
+	 * @brief Follow the table from a board to the nearest success state
+	 *
+	 * @param 	board 	The starting board
+	 * @param 	table 	An optional neighbor table, used to step between states without
+	 * 					permuting boards
+	 * @return 			An optimal sequence of moves, or an empty sequence if the board is already a success state or
+	 * 					can't reach one
+	 */
+	std::vector<int> PolicyTable::solve(board_t board, const neighbors::NeighborTable* table) const {
+		std::vector<int> moves;
+		int index = treeutils::isValidBoardState(board);
+
+		if (index == -1 || distance(index) == UNSOLVABLE) {
+			return moves;
+		}
+
+		moves.reserve(distance(index));
+
+		for (int move = bestMove(index); move != 0; move = bestMove(index)) {
+			moves.push_back(move);
+			index = table? table->neighbor(index, move) : neighbors::computeNeighbor(index, move);
+		}
+
+		return moves;
+	}
+
+	/**
+	 * @brief Get the file a card's policy table is stored in
+	 *
+	 * @param 	directory 	The directory holding the tables
+	 * @param 	target 		The ID of the target card
+	 * @return 				The path of the table
+	 */
+	std::string policyPath(const std::string& directory, const std::string& target) {
+		return (std::filesystem::path(directory) / ("policy-" + target + ".bin")).string();
+	}
+
+	/**
+	 * @brief Build and store the policy table of every target card
+	 *
+	 * @param 	table 		A loaded neighbor table
+	 * @param 	directory 	The directory to store the tables in
+	 * @param 	threads 	The number of threads to use, or 0 for one per hardware thread
+	 * @return 				The number of tables written
+	 */
+	std::size_t buildAll(const neighbors::NeighborTable& table, const std::string& directory, unsigned threads) {
+		std::filesystem::create_directories(directory);
+		std::size_t written = 0;
+
+		for (const auto& target: success_states::cardIDs()) {
+			PolicyTable policy;
+			policy.build(table, target, threads);
+			written += policy.save(policyPath(directory, target));
+		}
+
+		return written;
+	}
+}
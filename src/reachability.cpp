@@ -0,0 +1,257 @@
+//
+// FILENAME: reachability.cpp | Shifting Stones Search
+// DESCRIPTION: Connected components of the state graph for constant-time solvability checks
+// CREATED: 2026-10-20 @ 9:20 AM
+//
+
+#include "reachability.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <thread>
+
+#include "successstates.hpp"
+#include "treeutils.hpp"
+
+namespace reachability {
+	namespace __detail {
+		/**
+		 * @brief Find the root of a state's set, halving the path on the way
+		 *
+		 * @note  Concurrent finds may both shorten the same path. Every parent written is an ancestor of the state,
+		 * 		  so the races only change how much of the path gets shortened.
+		 */
+		uint32_t find(std::vector<std::atomic<uint32_t>>& parents, uint32_t state) {
+			uint32_t parent = parents[state].load(std::memory_order_relaxed);
+
+			while (parent != state) {
+				uint32_t grandparent = parents[parent].load(std::memory_order_relaxed);
+				parents[state].compare_exchange_weak(parent, grandparent, std::memory_order_relaxed);
+
+				state = parent;
+				parent = parents[state].load(std::memory_order_relaxed);
+			}
+
+			return state;
+		}
+
+		/**
+		 * @brief Join the sets holding two states
+		 *
+		 * @note  The larger root is always linked below the smaller one, so concurrent unions can't form a cycle
+		 */
+		void unite(std::vector<std::atomic<uint32_t>>& parents, uint32_t first, uint32_t second) {
+			while (true) {
+				first = find(parents, first);
+				second = find(parents, second);
+
+				if (first == second) {
+					return;
+				}
+
+				if (first < second) {
+					std::swap(first, second);
+				}
+
+				uint32_t expected = first;
+				if (parents[first].compare_exchange_strong(expected, second)) {
+					return;
+				}
+			}
+		}
+
+		/**
+		 * @struct __index_header
+		 * @brief The header written in front of a stored component index
+		 */
+		struct __index_header {
+			uint32_t states; 		// The number of labeled states
+			uint32_t components; 	// The number of components
+			uint32_t cards; 		// The number of cards with goal flags
+			uint32_t flagWords; 	// The number of flag words per card
+		};
+	}
+
+	/**
+	 * @brief Label the connected components of the state graph
+	 *
+	 * @param 	table 	A loaded neighbor table
+	 * @param 	threads The number of threads to use, or 0 for one per hardware thread
+	 *
+	 * @note 			Edges are joined with a concurrent union-find, with states split evenly between threads
+	 */
+	void ComponentIndex::build(const neighbors::NeighborTable& table, unsigned threads) {
+		threads = threads? threads : std::max(1U, std::thread::hardware_concurrency());
+
+		std::vector<std::atomic<uint32_t>> parents(MAX_BOARD_STATES);
+		for (uint32_t i = 0; i < MAX_BOARD_STATES; i++) {
+			parents[i].store(i, std::memory_order_relaxed);
+		}
+
+		const std::size_t SLICE = (MAX_BOARD_STATES + threads - 1) / threads;
+
+		{
+			std::vector<std::jthread> workers;
+
+			for (unsigned t = 0; t < threads; t++) {
+				workers.emplace_back([&, t]() {
+					const std::size_t END = std::min<std::size_t>(MAX_BOARD_STATES, (t + 1) * SLICE);
+
+					for (std::size_t state = t * SLICE; state < END; state++) {
+						const uint32_t* row = table.row(state);
+
+						// Each edge shows up in both rows, so only join it from its smaller end
+						for (std::size_t move = 0; move < POSSIBLE_CONFIGS; move++) {
+							if (row[move] > state) {
+								__detail::unite(parents, state, row[move]);
+							}
+						}
+					}
+				});
+			}
+		}
+
+		// Number the components in order of their smallest state
+		labels.assign(MAX_BOARD_STATES, 0);
+		components = 0;
+
+		for (uint32_t i = 0; i < MAX_BOARD_STATES; i++) {
+			uint32_t root = __detail::find(parents, i);
+			labels[i] = (root == i)? components++ : labels[root];
+		}
+
+		flagGoals();
+	}
+
+	/**
+	 * @brief Record which components hold a success state for each card
+	 *
+	 * @note  Scanning for a card stops as soon as every component has been flagged
+	 */
+	void ComponentIndex::flagGoals() {
+		const auto& cards = success_states::cardIDs();
+		flagWords = (components + 63) / 64;
+		goalFlags.assign(cards.size() * flagWords, 0);
+
+		for (std::size_t card = 0; card < cards.size(); card++) {
+			const auto& states = success_states::SUCCESS_STATES.at(cards[card]);
+			uint64_t* flags = &goalFlags[card * flagWords];
+			uint32_t flagged = 0;
+
+			for (uint32_t i = 0; i < MAX_BOARD_STATES && flagged < components; i++) {
+				const uint32_t COMPONENT = labels[i];
+
+				if ((flags[COMPONENT / 64] >> (COMPONENT % 64)) & 1) {
+					continue;
+				}
+
+				for (const auto& state: states) {
+					if (success_states::matchesSuccessState(BOARD_STATES[i], state)) {
+						flags[COMPONENT / 64] |= 1ULL << (COMPONENT % 64);
+						flagged++;
+						break;
+					}
+				}
+			}
+		}
+	}
+
+	/**
+	 * @brief Load an index stored with `ComponentIndex::save`
+	 *
+	 * @param 	path 	The file to read
+	 * @return 			`true` if the index was read, `false` otherwise
+	 */
+	bool ComponentIndex::load(const std::string& path) {
+		FILE* file = fopen(path.c_str(), "rb");
+		if (!file) {
+			return false;
+		}
+
+		__detail::__index_header header;
+		bool read = fread(&header, sizeof(header), 1, file) == 1
+			&& header.states == MAX_BOARD_STATES
+			&& header.cards == success_states::cardIDs().size();
+
+		if (read) {
+			labels.resize(header.states);
+			goalFlags.resize(header.cards * header.flagWords);
+			components = header.components;
+			flagWords = header.flagWords;
+
+			read = fread(labels.data(), sizeof(uint32_t), labels.size(), file) == labels.size()
+				&& fread(goalFlags.data(), sizeof(uint64_t), goalFlags.size(), file) == goalFlags.size();
+		}
+
+		fclose(file);
+
+		if (!read) {
+			labels.clear();
+			goalFlags.clear();
+		}
+
+		return read;
+	}
+
+	/**
+	 * @brief Store the index in a binary file
+	 *
+	 * @param 	path 	The file to write
+	 * @return 			`true` if the index was written, `false` otherwise
+	 */
+	bool ComponentIndex::save(const std::string& path) const {
+		FILE* file = fopen(path.c_str(), "wb");
+		if (!file) {
+			return false;
+		}
+
+		const __detail::__index_header HEADER = {
+			(uint32_t)labels.size(), components, (uint32_t)success_states::cardIDs().size(), flagWords
+		};
+
+		bool written = fwrite(&HEADER, sizeof(HEADER), 1, file) == 1
+			&& fwrite(labels.data(), sizeof(uint32_t), labels.size(), file) == labels.size()
+			&& fwrite(goalFlags.data(), sizeof(uint64_t), goalFlags.size(), file) == goalFlags.size();
+
+		return (fclose(file) == 0) && written;
+	}
+
+	/**
+	 * @brief Check if a board can reach any success state for a target card
+	 *
+	 * @param 	board 	The starting board
+	 * @param 	target 	The ID of the target card
+	 * @return 			`false` if no sequence of moves satisfies the card, `true` otherwise
+	 */
+	bool ComponentIndex::solvable(board_t board, const std::string& target) const {
+		int index = treeutils::isValidBoardState(board);
+		int card = success_states::cardIndex(target);
+
+		return index != -1 && card != -1 && solvable((uint32_t)index, card);
+	}
+
+	/**
+	 * @brief Check if a state can reach any success state for a target card
+	 *
+	 * @param 	index 	The `BOARD_STATES` index of the starting state
+	 * @param 	card 	The index of the target card in `success_states::cardIDs`
+	 * @return 			`false` if no sequence of moves satisfies the card, `true` otherwise
+	 */
+	bool ComponentIndex::solvable(uint32_t index, int card) const {
+		const uint32_t COMPONENT = labels[index];
+		return (goalFlags[card * flagWords + COMPONENT / 64] >> (COMPONENT % 64)) & 1;
+	}
+
+	/**
+	 * @brief Check if one board can be turned into another
+	 *
+	 * @param 	first 	The first board
+	 * @param 	second 	The second board
+	 * @return 			`true` if both boards are valid and in the same component, `false` otherwise
+	 */
+	bool ComponentIndex::connected(board_t first, board_t second) const {
+		int a = treeutils::isValidBoardState(first), b = treeutils::isValidBoardState(second);
+		return a != -1 && b != -1 && labels[a] == labels[b];
+	}
+}
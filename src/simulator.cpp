@@ -0,0 +1,304 @@
+//
+// FILENAME: simulator.cpp | Shifting Stones Search
+// DESCRIPTION: Play many complete games in parallel and gather statistics on them
+// CREATED: 2026-10-24 @ 5:15 PM
+//
+
+#include "simulator.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <random>
+#include <thread>
+
+#include "boardstates.h"
+#include "successstates.hpp"
+#include "treeutils.hpp"
+
+namespace simulator {
+	namespace __detail {
+		/**
+		 * @brief The number of games a thread claims at a time. Stop requests and deadlines are checked between them.
+		 */
+		const std::size_t CHUNK_SIZE = 256;
+
+		/**
+		 * @struct __held
+		 * @brief A card in a player's hand
+		 */
+		struct __held {
+			int card; 	// The card's index in `success_states::cardIDs`
+			int since; 	// The turn the card was drawn on
+		};
+
+		/**
+		 * @struct __tables
+		 * @brief Read-only data shared by every thread
+		 */
+		struct __tables {
+			std::vector<int> 								   deck; 		// The card index of each card in the deck
+			std::vector<const std::vector<success_states::GoalMask>*> masks; 	// The goal masks of each card, by card index
+			std::vector<std::vector<uint8_t>> 				   distances; 	// Each deck card's distance from every state, for `Policy::Exact`
+		};
+
+		/**
+		 * @brief Pick a player's next board
+		 *
+		 * @param 	policy 	How the player picks
+		 * @param 	board 	The current board
+		 * @param 	hand 	The player's cards
+		 * @param 	tables 	The shared tables
+		 * @param 	options The simulation settings
+		 * @param 	random 	The calling thread's random generator
+		 * @return 			The board after the chosen move. Ties between equally good moves are broken at random.
+		 */
+		board_t __move(Policy policy, board_t board, const std::vector<__held>& hand, const __tables& tables, const Options& options, std::mt19937_64& random) {
+			if (policy == Policy::Random || hand.empty()) {
+				board_t next = board;
+
+				while (next == board) {
+					next = treeutils::__permuteBoard(board, random() % POSSIBLE_CONFIGS + 1);
+				}
+
+				return next;
+			}
+
+			const int STATE = (policy == Policy::Exact)? treeutils::isValidBoardState(board) : -1;
+			board_t best = board;
+			int bestScore = INT32_MAX, ties = 0;
+
+			for (int move = 1; move <= (int)POSSIBLE_CONFIGS; move++) {
+				board_t next;
+				uint32_t nextState = 0;
+
+				if (policy == Policy::Exact) {
+					nextState = options.table->neighbor(STATE, move);
+					next = BOARD_STATES[nextState];
+				}
+				else {
+					next = treeutils::__permuteBoard(board, move);
+				}
+
+				// Swapping two identical tiles doesn't change the board, so it isn't a real move
+				if (next == board) {
+					continue;
+				}
+
+				int score = INT32_MAX;
+				for (const __held& held: hand) {
+					score = std::min(score, (policy == Policy::Exact)? (int)tables.distances[held.card][nextState] : success_states::lowerBound(next, *tables.masks[held.card]));
+				}
+
+				// Keep each of the tied moves with equal probability
+				if (score < bestScore) {
+					best = next;
+					bestScore = score;
+					ties = 1;
+				}
+				else if (score == bestScore && random() % ++ties == 0) {
+					best = next;
+				}
+			}
+
+			return best;
+		}
+
+		/**
+		 * @brief Play one game from a random board
+		 *
+		 * @param 	tables 	The shared tables
+		 * @param 	options The simulation settings
+		 * @param 	random 	The calling thread's random generator
+		 * @param 	stats 	The calling thread's totals, which the game is added to
+		 *
+		 * @note 			Players take turns in order. After each of their moves, a player completes every card in their
+		 * 					hand the board matches and draws a replacement for each while the deck lasts.
+		 */
+		void __play(const __tables& tables, const Options& options, std::mt19937_64& random, Stats& stats) {
+			const int PLAYERS = options.policies.size();
+
+			std::vector<int> deck = tables.deck;
+			std::shuffle(deck.begin(), deck.end(), random);
+			std::size_t top = 0;
+
+			std::vector<std::vector<__held>> hands(PLAYERS);
+			std::vector<int> completed(PLAYERS, 0);
+
+			auto draw = [&](int player, int turn) {
+				if (top < deck.size()) {
+					hands[player].push_back({deck[top], turn});
+					stats.cards[deck[top++]].dealt++;
+				}
+			};
+
+			for (int player = 0; player < PLAYERS; player++) {
+				for (int i = 0; i < options.handSize; i++) {
+					draw(player, 0);
+				}
+			}
+
+			board_t board = treeutils::randomBoard(random);
+			int turn = 0, winner = -1;
+
+			for (; turn < options.maxTurns && winner == -1; turn++) {
+				const int PLAYER = turn % PLAYERS;
+				std::vector<__held>& hand = hands[PLAYER];
+
+				for (int move = 0; move < options.movesPerTurn && winner == -1; move++) {
+					board = __move(options.policies[PLAYER], board, hand, tables, options, random);
+
+					for (std::size_t i = 0; i < hand.size();) {
+						if (!success_states::matchesAny(board, *tables.masks[hand[i].card])) {
+							i++;
+							continue;
+						}
+
+						CardStats& card = stats.cards[hand[i].card];
+						card.completed++;
+						card.turnsHeld += turn - hand[i].since;
+
+						hand.erase(hand.begin() + i);
+						draw(PLAYER, turn);
+
+						if (++completed[PLAYER] >= options.cardsToWin) {
+							winner = PLAYER;
+							break;
+						}
+					}
+				}
+			}
+
+			stats.games++;
+			stats.turns += turn;
+			stats.lengths[turn]++;
+
+			if (winner == -1) {
+				stats.unfinished++;
+			}
+			else {
+				stats.wins[winner]++;
+			}
+		}
+	}
+
+	/**
+	 * @brief Add another set of totals to this one
+	 *
+	 * @param 	other 	The totals to add. Their histograms may be a different size.
+	 */
+	void Stats::merge(const Stats& other) {
+		games += other.games;
+		turns += other.turns;
+		unfinished += other.unfinished;
+
+		lengths.resize(std::max(lengths.size(), other.lengths.size()), 0);
+		for (std::size_t i = 0; i < other.lengths.size(); i++) {
+			lengths[i] += other.lengths[i];
+		}
+
+		wins.resize(std::max(wins.size(), other.wins.size()), 0);
+		for (std::size_t i = 0; i < other.wins.size(); i++) {
+			wins[i] += other.wins[i];
+		}
+
+		cards.resize(std::max(cards.size(), other.cards.size()));
+		for (std::size_t i = 0; i < other.cards.size(); i++) {
+			cards[i].dealt += other.cards[i].dealt;
+			cards[i].completed += other.cards[i].completed;
+			cards[i].turnsHeld += other.cards[i].turnsHeld;
+		}
+	}
+
+	/**
+	 * @brief Play a batch of games
+	 *
+	 * @param 	options The games to play
+	 * @param 	budget 	Limits on how much the simulation may do. `maxNodes` caps the games, and `maxDepth` and
+	 * 					`maxMemory` don't apply.
+	 * @return 			The totals of every game played. The status is `Unsolvable` if the options are invalid.
+	 *
+	 * @note 			Each thread claims games in chunks, plays them with its own random generator and its own
+	 * 					totals, and merges its totals once at the end, so threads never contend while playing. With
+	 * 					`Policy::Exact`, each deck card's distances are computed once up front.
+	 */
+	Stats run(const Options& options, const solver::Budget& budget) {
+		Stats stats;
+		const int PLAYERS = options.policies.size();
+		const bool EXACT = std::find(options.policies.begin(), options.policies.end(), Policy::Exact) != options.policies.end();
+
+		if (PLAYERS < 1 || PLAYERS > MAX_PLAYERS || options.handSize < 1 || options.movesPerTurn < 1 || options.maxTurns < 1 || (EXACT && !options.table)) {
+			return stats;
+		}
+
+		const std::vector<std::string>& ids = success_states::cardIDs();
+		__detail::__tables tables;
+
+		for (const std::string& card: options.deck.empty()? ids : options.deck) {
+			if (int index = success_states::cardIndex(card); index != -1) {
+				tables.deck.push_back(index);
+			}
+		}
+
+		if (tables.deck.empty()) {
+			return stats;
+		}
+
+		tables.masks.resize(ids.size());
+		tables.distances.resize(EXACT? ids.size() : 0);
+
+		for (int card: tables.deck) {
+			tables.masks[card] = &success_states::goalMasks(ids[card]);
+
+			if (EXACT && tables.distances[card].empty()) {
+				tables.distances[card] = neighbors::distances(*options.table, success_states::goalStates(ids[card]));
+			}
+		}
+
+		const std::size_t TARGET = budget.maxNodes? std::min(options.games, budget.maxNodes) : options.games;
+		const unsigned THREADS = options.threads? options.threads : std::max(1U, std::thread::hardware_concurrency());
+		const uint64_t SEED = options.seed? options.seed : std::random_device()();
+
+		std::atomic<std::size_t> claimed = 0;
+		std::mutex merging;
+
+		stats.lengths.assign(options.maxTurns + 1, 0);
+		stats.wins.assign(PLAYERS, 0);
+		stats.cards.resize(ids.size());
+
+		auto worker = [&](unsigned thread) {
+			std::mt19937_64 random(SEED + thread * 0x9E3779B97F4A7C15ULL);
+			Stats local;
+			local.lengths.assign(options.maxTurns + 1, 0);
+			local.wins.assign(PLAYERS, 0);
+			local.cards.resize(ids.size());
+
+			while (!budget.stop.stop_requested() && solver::clock_type::now() < budget.deadline) {
+				const std::size_t FIRST = claimed.fetch_add(__detail::CHUNK_SIZE, std::memory_order_relaxed);
+				if (FIRST >= TARGET) {
+					break;
+				}
+
+				for (std::size_t game = FIRST; game < std::min(TARGET, FIRST + __detail::CHUNK_SIZE); game++) {
+					__detail::__play(tables, options, random, local);
+				}
+			}
+
+			std::lock_guard<std::mutex> lock(merging);
+			stats.merge(local);
+		};
+
+		{
+			std::vector<std::jthread> workers;
+			for (unsigned t = 0; t < THREADS; t++) {
+				workers.emplace_back(worker, t);
+			}
+		}
+
+		stats.status = (stats.games >= TARGET)? solver::Status::Solved
+			: budget.stop.stop_requested()? solver::Status::Cancelled
+			: solver::Status::TimedOut;
+
+		return stats;
+	}
+}
@@ -0,0 +1,289 @@
+//
+// FILENAME: solutioncache.cpp | Shifting Stones Search
+// DESCRIPTION: A bounded cache of search results shared across queries
+// CREATED: 2026-10-22 @ 9:30 AM
+//
+
+#include "solutioncache.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+
+#include "batch.hpp"
+#include "successstates.hpp"
+#include "treeutils.hpp"
+
+namespace solutioncache {
+	namespace __detail {
+		/**
+		 * @brief Identifies a stored cache file
+		 */
+		const char CACHE_MAGIC[4] = {'S', 'S', 'S', 'C'};
+		const uint32_t CACHE_VERSION = 1;
+
+		/**
+		 * @struct __cache_header
+		 * @brief The header written in front of a stored cache
+		 */
+		struct __cache_header {
+			char 	 magic[4];
+			uint32_t version;
+			uint64_t count; // The number of entries that follow
+		};
+
+		/**
+		 * @brief Pack a query into a cache key
+		 *
+		 * @param 	board 		The starting board
+		 * @param 	card 		The index of the target card
+		 * @param 	maxDepth 	The depth limit of the query, or -1 for none
+		 * @return 				The key
+		 */
+		inline uint64_t key(board_t board, int card, int maxDepth) {
+			return (uint64_t)(board & ((1ULL << USABLE_BOARD) - 1))
+				| (uint64_t)(card & 0x7F) << USABLE_BOARD
+				| (uint64_t)(std::clamp(maxDepth, -1, 126) + 1) << (USABLE_BOARD + 7);
+		}
+	}
+
+	/**
+	 * @brief Create an empty cache, loading it from its backing file if one is set
+	 *
+	 * @param 	options The cache settings
+	 */
+	SolutionCache::SolutionCache(const Options& options):
+		options(options),
+		capacity(std::max<std::size_t>(1, options.maxBytes / ENTRY_BYTES))
+	{
+		entries.reserve(capacity);
+		index.reserve(capacity);
+		referenced = std::make_unique<std::atomic<bool>[]>(capacity);
+
+		if (!options.path.empty()) {
+			load(options.path);
+		}
+	}
+
+	/**
+	 * @brief Save the cache to its backing file if one is set
+	 */
+	SolutionCache::~SolutionCache() {
+		if (!options.path.empty()) {
+			save(options.path);
+		}
+	}
+
+	/**
+	 * @brief Look up the result of a query
+	 *
+	 * @param 	board 		The starting board
+	 * @param 	target 		The ID of the target card
+	 * @param 	maxDepth 	The depth limit of the query, or -1 for none
+	 * @param 	solution 	Filled with the cached result if there is one
+	 * @return 				`true` on a hit, `false` on a miss
+	 */
+	bool SolutionCache::lookup(board_t board, const std::string& target, int maxDepth, solver::Solution& solution) {
+		const uint64_t KEY = __detail::key(board, success_states::cardIndex(target), maxDepth);
+		__cache_entry entry;
+
+		{
+			std::shared_lock<std::shared_mutex> guard(lock);
+			auto found = index.find(KEY);
+
+			if (found == index.end()) {
+				misses++;
+				return false;
+			}
+
+			referenced[found->second].store(true, std::memory_order_relaxed);
+			entry = entries[found->second];
+		}
+
+		hits++;
+
+		solution.status = (solver::Status)entry.status;
+		solution.moves = batch::decodeMoves(entry.moves, entry.count);
+		solution.optimal = entry.optimal;
+		solution.lowerBound = entry.lowerBound;
+		solution.board = (solution.status == solver::Status::Unsolvable)? 0 : board;
+
+		for (int move: solution.moves) {
+			solution.board = treeutils::__permuteBoard(solution.board, move);
+		}
+
+		return true;
+	}
+
+	/**
+	 * @brief Store the result of a query
+	 *
+	 * @param 	board 		The starting board
+	 * @param 	target 		The ID of the target card
+	 * @param 	maxDepth 	The depth limit of the query, or -1 for none
+	 * @param 	solution 	The result. Results with more than `batch::MAX_ENCODED_MOVES` moves aren't stored.
+	 */
+	void SolutionCache::insert(board_t board, const std::string& target, int maxDepth, const solver::Solution& solution) {
+		const int CARD = success_states::cardIndex(target);
+
+		if (CARD == -1 || solution.moves.size() > (std::size_t)batch::MAX_ENCODED_MOVES) {
+			return;
+		}
+
+		std::unique_lock<std::shared_mutex> guard(lock);
+		store({
+			__detail::key(board, CARD, maxDepth),
+			batch::encodeMoves(solution.moves),
+			(uint8_t)solution.moves.size(),
+			(uint8_t)solution.status,
+			(uint8_t)solution.optimal,
+			(uint8_t)std::clamp(solution.lowerBound, 0, UINT8_MAX)
+		});
+	}
+
+	/**
+	 * @brief Add or replace an entry, evicting one if the cache is full
+	 *
+	 * @param 	entry 	The entry to store
+	 *
+	 * @note 			The caller must hold the exclusive lock
+	 */
+	void SolutionCache::store(const __cache_entry& entry) {
+		if (auto found = index.find(entry.key); found != index.end()) {
+			entries[found->second] = entry;
+			return;
+		}
+
+		std::size_t slot = entries.size();
+
+		if (entries.size() < capacity) {
+			entries.push_back(entry);
+		} else {
+			// Give every recently used entry a second chance
+			while (referenced[hand].exchange(false, std::memory_order_relaxed)) {
+				hand = (hand + 1) % capacity;
+			}
+
+			slot = hand;
+			hand = (hand + 1) % capacity;
+
+			index.erase(entries[slot].key);
+			entries[slot] = entry;
+			evictions++;
+		}
+
+		index[entry.key] = slot;
+		referenced[slot].store(false, std::memory_order_relaxed);
+	}
+
+	/**
+	 * @brief Answer a query from the cache, searching and storing the result on a miss
+	 *
+	 * @param 	board 	The starting board
+	 * @param 	target 	The ID of the target card
+	 * @param 	budget 	Limits on how much a search may do. `budget.maxDepth` is part of the key.
+	 * @param 	table 	An optional neighbor table
+	 * @return 			The solution
+	 *
+	 * @note 			Only results that any search with the same depth limit would repeat are stored. Results cut
+	 * 					short by a deadline, stop request, node cap or memory cap are returned but not cached.
+	 */
+	solver::Solution SolutionCache::solve(board_t board, const std::string& target, const solver::Budget& budget, const neighbors::NeighborTable* table) {
+		solver::Solution solution;
+
+		if (lookup(board, target, budget.maxDepth, solution)) {
+			return solution;
+		}
+
+		solution = solver::solve(board, target, budget, table);
+
+		const bool FINAL = solution.status == solver::Status::Solved || solution.status == solver::Status::Unsolvable
+			|| (solution.status == solver::Status::Exhausted && !budget.maxNodes && !budget.maxMemory);
+
+		if (FINAL) {
+			insert(board, target, budget.maxDepth, solution);
+		}
+
+		return solution;
+	}
+
+	/**
+	 * @brief Add the entries stored with `SolutionCache::save`
+	 *
+	 * @param 	path 	The file to read
+	 * @return 			`true` if the file was read, `false` otherwise
+	 *
+	 * @note 			Entries beyond the cache's capacity evict earlier ones as usual
+	 */
+	bool SolutionCache::load(const std::string& path) {
+		FILE* file = fopen(path.c_str(), "rb");
+		if (!file) {
+			return false;
+		}
+
+		__detail::__cache_header header;
+		bool read = fread(&header, sizeof(header), 1, file) == 1
+			&& memcmp(header.magic, __detail::CACHE_MAGIC, sizeof(header.magic)) == 0
+			&& header.version == __detail::CACHE_VERSION;
+
+		std::unique_lock<std::shared_mutex> guard(lock);
+		__cache_entry entry;
+
+		for (uint64_t i = 0; read && i < header.count; i++) {
+			read = fread(&entry, sizeof(entry), 1, file) == 1;
+
+			if (read) {
+				store(entry);
+			}
+		}
+
+		fclose(file);
+		return read;
+	}
+
+	/**
+	 * @brief Store every entry in a binary file
+	 *
+	 * @param 	path 	The file to write
+	 * @return 			`true` if the cache was written, `false` otherwise
+	 */
+	bool SolutionCache::save(const std::string& path) const {
+		FILE* file = fopen(path.c_str(), "wb");
+		if (!file) {
+			return false;
+		}
+
+		std::shared_lock<std::shared_mutex> guard(lock);
+		__detail::__cache_header header = {};
+
+		memcpy(header.magic, __detail::CACHE_MAGIC, sizeof(header.magic));
+		header.version = __detail::CACHE_VERSION;
+		header.count = entries.size();
+
+		bool written = fwrite(&header, sizeof(header), 1, file) == 1
+			&& fwrite(entries.data(), sizeof(__cache_entry), entries.size(), file) == entries.size();
+
+		return (fclose(file) == 0) && written;
+	}
+
+	/**
+	 * @brief Remove every entry and reset the counters
+	 */
+	void SolutionCache::clear() {
+		std::unique_lock<std::shared_mutex> guard(lock);
+
+		entries.clear();
+		index.clear();
+		hand = 0;
+		hits = misses = evictions = 0;
+	}
+
+	/**
+	 * @brief Get the cache's counters
+	 */
+	Stats SolutionCache::stats() const {
+		std::shared_lock<std::shared_mutex> guard(lock);
+		return {hits.load(), misses.load(), evictions.load(), entries.size(), capacity};
+	}
+}
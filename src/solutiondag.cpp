@@ -0,0 +1,243 @@
+//
+// FILENAME: solutiondag.cpp | Shifting Stones Search
+// DESCRIPTION: Every optimal solution to a query, stored as a layered graph
+// CREATED: 2026-10-23 @ 5:10 PM
+//
+
+#include "solutiondag.hpp"
+
+#include <algorithm>
+#include <bit>
+
+#include "boardstates.h"
+#include "successstates.hpp"
+#include "treeutils.hpp"
+
+namespace solutiondag {
+	namespace __detail {
+		/**
+		 * @brief The number of states expanded between checks of the stop token and deadline
+		 */
+		const std::size_t CHECK_INTERVAL = 4096;
+	}
+
+	/**
+	 * @brief Find every optimal solution to a single query
+	 *
+	 * @param 	board 	The starting board
+	 * @param 	target 	The ID of the target card
+	 * @param 	budget 	Limits on how much the search may do. `maxMemory` doesn't apply.
+	 * @param 	table 	An optional neighbor table
+	 * @return 			The solutions. If the budget runs out first, the status says why and no levels are returned.
+	 *
+	 * @note 			A breadth-first search runs forward until a level holds a success state, then a backward pass
+	 * 					keeps only the states with a move into the kept part of the next level. Neighbors always lie
+	 * 					within one level of each other, so that move can only lead one level deeper.
+	 */
+	SolutionDAG enumerate(board_t board, const std::string& target, const solver::Budget& budget, const neighbors::NeighborTable* table) {
+		SolutionDAG dag;
+		int root = treeutils::isValidBoardState(board);
+		auto card = success_states::SUCCESS_STATES.find(target);
+
+		if (root == -1 || card == success_states::SUCCESS_STATES.end()) {
+			return dag;
+		}
+
+		auto neighbor = [table](uint32_t state, int move) {
+			return table? table->neighbor(state, move) : neighbors::computeNeighbor(state, move);
+		};
+
+		// Whether each state has been reached. The backward pass reuses it to mark the states it keeps.
+		std::vector<uint8_t> marked(MAX_BOARD_STATES, 0);
+		std::vector<std::vector<uint32_t>> levels = {{(uint32_t)root}};
+		marked[root] = 1;
+
+		std::vector<uint32_t> goals;
+		std::size_t expanded = 0;
+
+		for (;;) {
+			for (uint32_t state: levels.back()) {
+				if (success_states::lowerBound(BOARD_STATES[state], card->second) == 0) {
+					goals.push_back(state);
+				}
+			}
+
+			if (!goals.empty()) {
+				break;
+			}
+
+			if (budget.maxDepth >= 0 && (int)levels.size() > budget.maxDepth) {
+				dag.status = solver::Status::Exhausted;
+				return dag;
+			}
+
+			std::vector<uint32_t> next;
+
+			for (uint32_t state: levels.back()) {
+				if (budget.maxNodes && expanded >= budget.maxNodes) {
+					dag.status = solver::Status::Exhausted;
+					return dag;
+				}
+
+				if (expanded++ % __detail::CHECK_INTERVAL == 0) {
+					if (budget.stop.stop_requested()) {
+						dag.status = solver::Status::Cancelled;
+						return dag;
+					}
+
+					if (solver::clock_type::now() >= budget.deadline) {
+						dag.status = solver::Status::TimedOut;
+						return dag;
+					}
+				}
+
+				for (int move = 1; move <= (int)POSSIBLE_CONFIGS; move++) {
+					if (uint32_t reached = neighbor(state, move); !marked[reached]) {
+						marked[reached] = 1;
+						next.push_back(reached);
+					}
+				}
+			}
+
+			if (next.empty()) {
+				return dag;
+			}
+
+			levels.push_back(std::move(next));
+		}
+
+		std::fill(marked.begin(), marked.end(), 0);
+		std::sort(goals.begin(), goals.end());
+
+		for (uint32_t goal: goals) {
+			marked[goal] = 1;
+		}
+
+		dag.levels.resize(levels.size());
+		dag.levels.back().states = std::move(goals);
+		dag.levels.back().moves.assign(dag.levels.back().states.size(), 0);
+
+		for (int depth = (int)levels.size() - 2; depth >= 0; depth--) {
+			Level& level = dag.levels[depth];
+			std::sort(levels[depth].begin(), levels[depth].end());
+
+			for (uint32_t state: levels[depth]) {
+				uint32_t moves = 0;
+
+				for (int move = 1; move <= (int)POSSIBLE_CONFIGS; move++) {
+					if (marked[neighbor(state, move)]) {
+						moves |= 1U << (move - 1);
+					}
+				}
+
+				if (moves) {
+					level.states.push_back(state);
+					level.moves.push_back(moves);
+				}
+			}
+
+			// Marked only after the whole level is scanned, so moves within the level are never counted
+			for (uint32_t state: level.states) {
+				marked[state] = 1;
+			}
+
+			std::vector<uint32_t>().swap(levels[depth]);
+		}
+
+		dag.status = solver::Status::Solved;
+		return dag;
+	}
+
+	/**
+	 * @brief Find every optimal solution to a single query with a precomputed policy table
+	 *
+	 * @param 	table 	A loaded neighbor table
+	 * @param 	policy 	The policy table of the target card
+	 * @param 	board 	The starting board
+	 * @return 			The solutions
+	 *
+	 * @note 			Every state reached by an optimal move lies on an optimal solution, so the levels are built
+	 * 					forward in one pass with nothing to prune
+	 */
+	SolutionDAG enumerate(const neighbors::NeighborTable& table, const policy::PolicyTable& policy, board_t board) {
+		SolutionDAG dag;
+		int root = treeutils::isValidBoardState(board);
+
+		if (root == -1 || policy.distance(root) == policy::UNSOLVABLE) {
+			return dag;
+		}
+
+		std::vector<uint8_t> reached(MAX_BOARD_STATES, 0);
+		dag.levels.resize(policy.distance(root) + 1);
+		dag.levels[0].states = {(uint32_t)root};
+
+		for (std::size_t depth = 0; depth < dag.levels.size(); depth++) {
+			Level& level = dag.levels[depth];
+			std::sort(level.states.begin(), level.states.end());
+			level.moves.reserve(level.states.size());
+
+			for (uint32_t state: level.states) {
+				const uint32_t MOVES = policy.optimalMoves(state);
+				level.moves.push_back(MOVES);
+
+				for (uint32_t mask = MOVES; mask != 0; mask &= mask - 1) {
+					if (uint32_t next = table.neighbor(state, std::countr_zero(mask) + 1); !reached[next]) {
+						reached[next] = 1;
+						dag.levels[depth + 1].states.push_back(next);
+					}
+				}
+			}
+		}
+
+		dag.status = solver::Status::Solved;
+		return dag;
+	}
+
+	/**
+	 * @brief Find a state in a level
+	 *
+	 * @param 	level 	The level to search
+	 * @param 	state 	The `BOARD_STATES` index of the state
+	 * @return 			The position of the state in the level, or -1 if it isn't there
+	 */
+	int find(const Level& level, uint32_t state) {
+		auto found = std::lower_bound(level.states.begin(), level.states.end(), state);
+		return (found != level.states.end() && *found == state)? found - level.states.begin() : -1;
+	}
+
+	/**
+	 * @brief Count the optimal solutions without listing them
+	 *
+	 * @param 	dag 	The solutions
+	 * @param 	table 	An optional neighbor table
+	 * @return 			The number of distinct move sequences from the starting board to a success state
+	 *
+	 * @note 			The count is built backward, one level at a time. Each state's count is the sum of the counts
+	 * 					of the states its moves lead to.
+	 */
+	uint64_t countPaths(const SolutionDAG& dag, const neighbors::NeighborTable* table) {
+		if (dag.levels.empty()) {
+			return 0;
+		}
+
+		std::vector<uint64_t> counts(dag.levels.back().states.size(), 1);
+
+		for (int depth = dag.depth() - 1; depth >= 0; depth--) {
+			const Level& level = dag.levels[depth];
+			std::vector<uint64_t> current(level.states.size(), 0);
+
+			for (std::size_t i = 0; i < level.states.size(); i++) {
+				for (uint32_t mask = level.moves[i]; mask != 0; mask &= mask - 1) {
+					const int MOVE = std::countr_zero(mask) + 1;
+					const uint32_t NEXT = table? table->neighbor(level.states[i], MOVE) : neighbors::computeNeighbor(level.states[i], MOVE);
+
+					current[i] += counts[find(dag.levels[depth + 1], NEXT)];
+				}
+			}
+
+			counts = std::move(current);
+		}
+
+		return counts[0];
+	}
+}
@@ -0,0 +1,154 @@
+//
+// FILENAME: solver.cpp | Shifting Stones Search
+// DESCRIPTION: Interruptible breadth-first search for a single (board, card) query
+// CREATED: 2026-10-21 @ 9:05 AM
+//
+
+#include "solver.hpp"
+
+#include <algorithm>
+
+#include "successstates.hpp"
+#include "treeutils.hpp"
+
+namespace solver {
+	namespace __detail {
+		/**
+		 * @brief The number of states expanded between checks of the stop token and deadline
+		 */
+		const std::size_t CHECK_INTERVAL = 4096;
+
+		/**
+		 * @brief Marks the root in the table of moves that reached each state
+		 */
+		const uint8_t ROOT_MOVE = 0xFF;
+	}
+
+	/**
+	 * @brief Find an optimal solution to a single query
+	 *
+	 * @param 	board 	The starting board
+	 * @param 	target 	The ID of the target card
+	 * @param 	budget 	Limits on how much the search may do
+	 * @param 	table 	An optional neighbor table. Without one, neighbors are found with
+	 * 					`__permuteBoard` and `isValidBoardState`.
+	 * @return 			The solution. If the budget runs out first, the reached board with the smallest
+	 * 					`success_states::lowerBound` is returned instead, along with the moves leading to it.
+	 *
+	 * @note 			The search never blocks or prints. It polls the stop token and deadline every
+	 * 					`CHECK_INTERVAL` expansions, so a stop request or passed deadline ends it within a fraction of a
+	 * 					millisecond.
+	 */
+	Solution solve(board_t board, const std::string& target, const Budget& budget, const neighbors::NeighborTable* table) {
+		Solution solution;
+		int root = treeutils::isValidBoardState(board);
+		auto card = success_states::SUCCESS_STATES.find(target);
+
+		if (root == -1 || card == success_states::SUCCESS_STATES.end()) {
+			return solution;
+		}
+
+		auto estimate = [&](uint32_t index) {
+			return success_states::lowerBound(BOARD_STATES[index], card->second);
+		};
+
+		// The move that first reached each state, or 0 if the state hasn't been reached
+		std::vector<uint8_t> reachedBy;
+		std::vector<uint32_t> queue;
+
+		// The memory cap covers the move table and the queue, which must be reserved up front so it can't outgrow it
+		const std::size_t FIXED_MEMORY = MAX_BOARD_STATES * sizeof(uint8_t);
+		const std::size_t MAX_QUEUE = !budget.maxMemory? MAX_BOARD_STATES
+			: (budget.maxMemory > FIXED_MEMORY)? std::min<std::size_t>(MAX_BOARD_STATES, (budget.maxMemory - FIXED_MEMORY) / sizeof(uint32_t))
+			: 0;
+
+		uint32_t best = root;
+		int bestEstimate = estimate(root);
+
+		auto finish = [&](Status status, uint32_t state, int lowerBound) {
+			solution.status = status;
+			solution.board = BOARD_STATES[state];
+			solution.optimal = status == Status::Solved;
+			solution.lowerBound = std::max(lowerBound, estimate(root));
+
+			// Every move is its own inverse, so the path is rebuilt by undoing the move that reached each state
+			for (; reachedBy[state] != __detail::ROOT_MOVE; state = table? table->neighbor(state, reachedBy[state]) : neighbors::computeNeighbor(state, reachedBy[state])) {
+				solution.moves.push_back(reachedBy[state]);
+			}
+
+			std::reverse(solution.moves.begin(), solution.moves.end());
+			return solution;
+		};
+
+		if (MAX_QUEUE == 0) {
+			solution.status = Status::Exhausted;
+			solution.board = board;
+			solution.lowerBound = bestEstimate;
+			return solution;
+		}
+
+		reachedBy.assign(MAX_BOARD_STATES, 0);
+		queue.reserve(budget.maxMemory? MAX_QUEUE : 0);
+		queue.push_back(root);
+		reachedBy[root] = __detail::ROOT_MOVE;
+
+		if (bestEstimate == 0) {
+			return finish(Status::Solved, root, 0);
+		}
+
+		// Every state up to `depth` has been reached by the time the states at `depth` are expanded, and none of them
+		// is a success state
+		int depth = 0;
+		for (std::size_t i = 0, levelEnd = 1; i < queue.size(); i++) {
+			if (i == levelEnd) {
+				depth++;
+				levelEnd = queue.size();
+			}
+
+			if (budget.maxDepth >= 0 && depth >= budget.maxDepth) {
+				return finish(Status::Exhausted, best, depth + 1);
+			}
+
+			if (budget.maxNodes && i >= budget.maxNodes) {
+				return finish(Status::Exhausted, best, depth + 1);
+			}
+
+			if (i % __detail::CHECK_INTERVAL == 0) {
+				if (budget.stop.stop_requested()) {
+					return finish(Status::Cancelled, best, depth + 1);
+				}
+
+				if (clock_type::now() >= budget.deadline) {
+					return finish(Status::TimedOut, best, depth + 1);
+				}
+			}
+
+			for (int move = 1; move <= (int)POSSIBLE_CONFIGS; move++) {
+				uint32_t next = table? table->neighbor(queue[i], move) : neighbors::computeNeighbor(queue[i], move);
+
+				if (reachedBy[next] != 0) {
+					continue;
+				}
+
+				if (queue.size() == MAX_QUEUE) {
+					return finish(Status::Exhausted, best, depth + 1);
+				}
+
+				reachedBy[next] = move;
+				queue.push_back(next);
+
+				// Breadth-first order means the first state reached with an estimate is the shallowest one
+				if (const int ESTIMATE = estimate(next); ESTIMATE < bestEstimate) {
+					best = next;
+					bestEstimate = ESTIMATE;
+
+					if (ESTIMATE == 0) {
+						return finish(Status::Solved, next, depth + 1);
+					}
+				}
+			}
+		}
+
+		return solution;
+	}
+}
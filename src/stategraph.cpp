@@ -0,0 +1,79 @@
+//
+// FILENAME: stategraph.cpp | Shifting Stones Search
+// DESCRIPTION: The full state graph as a Boost compressed sparse row graph
+// CREATED: 2026-10-23 @ 1:25 PM
+//
+
+#include "stategraph.hpp"
+
+
+#include <boost/graph/breadth_first_search.hpp>
+#include <boost/iterator/counting_iterator.hpp>
+#include <boost/iterator/filter_iterator.hpp>
+#include <boost/iterator/transform_iterator.hpp>
+
+namespace stategraph {
+	/**
+	 * @brief Build the state graph
+	 *
+	 * @param 	table 	An optional neighbor table. Without one, neighbors are found with
+	 * 					`__permuteBoard` and `isValidBoardState`.
+	 * @return 			The graph, with one edge per move that changes the board
+	 *
+	 * @note 			Edges are generated in source order straight into the graph's arrays, so no edge list is
+	 * 					held in memory. The graph takes about 4 bytes per vertex and 5 bytes per edge.
+	 */
+	graph_t build(const neighbors::NeighborTable* table) {
+		using slot_t = uint64_t; // A (state, move) pair, numbered `state * POSSIBLE_CONFIGS + move - 1`
+
+		auto target = [table](slot_t slot) -> uint32_t {
+			const uint32_t STATE = slot / POSSIBLE_CONFIGS;
+			const int MOVE = slot % POSSIBLE_CONFIGS + 1;
+
+			return table? table->neighbor(STATE, MOVE) : neighbors::computeNeighbor(STATE, MOVE);
+		};
+
+		// Swapping two identical tiles leaves the board as it was, which isn't a real edge
+		auto changesBoard = [&target](slot_t slot) {
+			return target(slot) != slot / POSSIBLE_CONFIGS;
+		};
+
+		auto toEdge = [&target](slot_t slot) {
+			return std::make_pair((uint32_t)(slot / POSSIBLE_CONFIGS), target(slot));
+		};
+
+		auto toProperty = [](slot_t slot) {
+			return __detail::__edge_property {(uint8_t)(slot % POSSIBLE_CONFIGS + 1)};
+		};
+
+		const boost::counting_iterator<slot_t> FIRST(0), LAST((slot_t)MAX_BOARD_STATES * POSSIBLE_CONFIGS);
+		auto edges = boost::make_filter_iterator(changesBoard, FIRST, LAST);
+		auto edgesEnd = boost::make_filter_iterator(changesBoard, LAST, LAST);
+
+		return graph_t(
+			boost::edges_are_sorted,
+			boost::make_transform_iterator(edges, toEdge),
+			boost::make_transform_iterator(edgesEnd, toEdge),
+			boost::make_transform_iterator(edges, toProperty),
+			MAX_BOARD_STATES
+		);
+	}
+
+	/**
+	 * @brief Find the distance from a state to every other state with Boost's breadth-first search
+	 *
+	 * @param 	graph 	The state graph
+	 * @param 	source 	The `BOARD_STATES` index to measure from
+	 * @return 			The distance of each state, or `neighbors::UNREACHED`
+	 */
+	std::vector<uint8_t> distances(const graph_t& graph, vertex_t source) {
+		std::vector<uint8_t> distance(boost::num_vertices(graph), neighbors::UNREACHED);
+		distance[source] = 0;
+
+		boost::breadth_first_search(graph, source, boost::visitor(boost::make_bfs_visitor(
+			boost::record_distances(boost::make_iterator_property_map(distance.begin(), boost::get(boost::vertex_index, graph)), boost::on_tree_edge())
+		)));
+
+		return distance;
+	}
+}
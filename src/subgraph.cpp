@@ -0,0 +1,112 @@
+//
+// FILENAME: subgraph.cpp | Shifting Stones Search
+// DESCRIPTION: Extract small, deduplicated pieces of the state graph for visualization
+// CREATED: 2026-10-23 @ 10:15 AM
+//
+
+#include "subgraph.hpp"
+
+#include <bit>
+#include <unordered_map>
+
+#include "boardstates.h"
+#include "solutiondag.hpp"
+#include "treeutils.hpp"
+
+namespace subgraph {
+	/**
+	 * @brief Extract every board within a number of moves of a board, and every move between them
+	 *
+	 * @param 	table 	A loaded neighbor table
+	 * @param 	center 	The board at the center of the ball
+	 * @param 	hops 	The largest number of moves from `center`
+	 * @return 			The undirected subgraph, or an empty one if `center` isn't a valid board
+	 *
+	 * @note 			Distinct moves never lead to the same board, so each pair of boards is joined by one edge
+	 */
+	Subgraph ball(const neighbors::NeighborTable& table, board_t center, int hops) {
+		Subgraph graph;
+		int root = treeutils::isValidBoardState(center);
+
+		if (root == -1) {
+			return graph;
+		}
+
+		std::unordered_map<uint32_t, uint32_t> vertices = {{(uint32_t)root, 0}};
+		std::vector<uint32_t> states = {(uint32_t)root};
+
+		// Reach every board in the ball first, so edges between boards on the boundary are kept too
+		for (std::size_t i = 0, levelEnd = 1, depth = 0; i < states.size() && (int)depth < hops; i++) {
+			for (int move = 1; move <= (int)POSSIBLE_CONFIGS; move++) {
+				if (uint32_t next = table.neighbor(states[i], move); vertices.try_emplace(next, states.size()).second) {
+					states.push_back(next);
+				}
+			}
+
+			if (i + 1 == levelEnd) {
+				depth++;
+				levelEnd = states.size();
+			}
+		}
+
+		graph.boards.reserve(states.size());
+		for (uint32_t state: states) {
+			graph.boards.push_back(BOARD_STATES[state]);
+		}
+
+		for (uint32_t vertex = 0; vertex < states.size(); vertex++) {
+			for (int move = 1; move <= (int)POSSIBLE_CONFIGS; move++) {
+				auto found = vertices.find(table.neighbor(states[vertex], move));
+
+				if (found != vertices.end() && found->second > vertex) {
+					graph.edges.emplace_back(vertex, found->second);
+					graph.moves.push_back(move);
+				}
+			}
+		}
+
+		return graph;
+	}
+
+	/**
+	 * @brief Extract every optimal path from a board to a target card
+	 *
+	 * @param 	table 	A loaded neighbor table
+	 * @param 	policy 	The policy table of the target card
+	 * @param 	board 	The starting board
+	 * @return 			The directed subgraph of optimal moves, or an empty one if the board isn't valid or can't reach
+	 * 					the card
+	 */
+	Subgraph optimalDAG(const neighbors::NeighborTable& table, const policy::PolicyTable& policy, board_t board) {
+		Subgraph graph;
+		graph.directed = true;
+
+		const solutiondag::SolutionDAG DAG = solutiondag::enumerate(table, policy, board);
+
+		// Vertices are numbered level by level, so each level starts where the previous one ended
+		std::vector<uint32_t> firstVertex = {0};
+		for (const solutiondag::Level& level: DAG.levels) {
+			firstVertex.push_back(firstVertex.back() + level.states.size());
+
+			for (uint32_t state: level.states) {
+				graph.boards.push_back(BOARD_STATES[state]);
+			}
+		}
+
+		for (int depth = 0; depth < DAG.depth(); depth++) {
+			const solutiondag::Level& level = DAG.levels[depth];
+
+			for (std::size_t i = 0; i < level.states.size(); i++) {
+				for (uint32_t mask = level.moves[i]; mask != 0; mask &= mask - 1) {
+					const int MOVE = std::countr_zero(mask) + 1;
+					const int NEXT = solutiondag::find(DAG.levels[depth + 1], table.neighbor(level.states[i], MOVE));
+
+					graph.edges.emplace_back(firstVertex[depth] + i, firstVertex[depth + 1] + NEXT);
+					graph.moves.push_back(MOVE);
+				}
+			}
+		}
+
+		return graph;
+	}
+}
@@ -6,8 +6,12 @@
 
 #include "successstates.hpp"
 
+#include <algorithm>
+#include <bit>
 #include <iostream>
 
+#include "boardstates.h"
+
 namespace success_states {
 
 	/**
@@ -67,4 +71,198 @@ namespace success_states {
 
 		return match;
 	}
-}
\ No newline at end of file
+
+	/**
+	 * @brief Count the tiles of a board that differ from a success state
+	 * 
+	 * @param 	board 	The board to compare
+	 * @param 	state 	A success state of a target card
+	 * @return 			The number of non-placeholder positions whose tile doesn't match
+	 */
+	int mismatchedTiles(board_t board, const std::string& state) {
+		int mismatched = 0;
+
+		for (std::size_t i = 0; i < state.size(); i++) {
+			const char TILE = ((board >> (24 - 3 * i)) & 0b111) + '0';
+			mismatched += state[i] != '8' && state[i] != '9' && state[i] != TILE;
+		}
+
+		return mismatched;
+	}
+
+	/**
+	 * @brief Estimate the number of moves needed to satisfy a target card
+	 * 
+	 * @param 	board 	The board to estimate from
+	 * @param 	target 	The ID of the target card
+	 * @return 			A lower bound on the number of moves, or `-1` if the card doesn't exist
+	 * 
+	 * @note 			A swap fixes at most two mismatched tiles and a flip fixes one, so half the mismatched tiles of
+	 * 					the closest success state, rounded up, never overestimates
+	 */
+	int lowerBound(board_t board, const std::string& target) {
+		auto found = SUCCESS_STATES.find(target);
+		return (found != SUCCESS_STATES.end())? lowerBound(board, found->second) : -1;
+	}
+
+	/**
+	 * @brief Estimate the number of moves needed to reach any of a set of success states
+	 * 
+	 * @param 	board 	The board to estimate from
+	 * @param 	states 	The success states of a target card
+	 * @return 			A lower bound on the number of moves, which is 0 only for a success state
+	 */
+	int lowerBound(board_t board, const std::vector<std::string>& states) {
+		int closest = 9;
+		for (const auto& state: states) {
+			closest = std::min(closest, mismatchedTiles(board, state));
+		}
+
+		return (closest + 1) / 2;
+	}
+
+	/**
+	 * @brief Get the ID of every target card, sorted
+	 * 
+	 * @return The card IDs. The position of an ID is its card index.
+	 */
+	const std::vector<std::string>& cardIDs() {
+		static const std::vector<std::string> IDS = []() {
+			std::vector<std::string> ids;
+			ids.reserve(SUCCESS_STATES.size());
+
+			for (const auto& [id, _]: SUCCESS_STATES) {
+				ids.push_back(id);
+			}
+
+			std::sort(ids.begin(), ids.end());
+			return ids;
+		}();
+
+		return IDS;
+	}
+
+	/**
+	 * @brief Get the numeric index of a target card
+	 * 
+	 * @param 	target 	The ID of the target card
+	 * @return 			The position of the card in `cardIDs`, or `-1` if the card doesn't exist
+	 */
+	int cardIndex(const std::string& target) {
+		const auto& ids = cardIDs();
+		auto found = std::lower_bound(ids.begin(), ids.end(), target);
+
+		return (found != ids.end() && *found == target)? (int)(found - ids.begin()) : -1;
+	}
+
+	/**
+	 * @brief Find every valid board that satisfies a target card
+	 * 
+	 * @param 	target 	The ID of the target card
+	 * @return 			The `BOARD_STATES` indices of the success states, in ascending order
+	 */
+	std::vector<uint32_t> goalStates(const std::string& target) {
+		std::vector<uint32_t> goals;
+		const std::vector<GoalMask>& masks = goalMasks(target);
+
+		if (masks.empty()) {
+			return goals;
+		}
+
+		for (uint32_t i = 0; i < MAX_BOARD_STATES; i++) {
+			if (matchesAny(BOARD_STATES[i], masks)) {
+				goals.push_back(i);
+			}
+		}
+
+		return goals;
+	}
+
+	/**
+	 * @brief Reduce a success state to bit masks
+	 * 
+	 * @param 	state 	A success state of a target card
+	 * @return 			The masks. Placeholder tiles (8 and 9) are left out of both.
+	 */
+	GoalMask goalMask(const std::string& state) {
+		GoalMask goal;
+
+		for (std::size_t i = 0; i < state.size(); i++) {
+			if (state[i] == '8' || state[i] == '9') {
+				continue;
+			}
+
+			const int SHIFT = 24 - 3 * i;
+			goal.mask |= (board_t)0b111 << SHIFT;
+			goal.value |= (board_t)(state[i] - '0') << SHIFT;
+		}
+
+		return goal;
+	}
+
+	/**
+	 * @brief Get the success states of a target card reduced to bit masks
+	 * 
+	 * @param 	target 	The ID of the target card
+	 * @return 			One mask per success state, or an empty list if the card doesn't exist
+	 * 
+	 * @note 			The masks of every card are built once, on first use
+	 */
+	const std::vector<GoalMask>& goalMasks(const std::string& target) {
+		static const std::unordered_map<std::string, std::vector<GoalMask>> MASKS = []() {
+			std::unordered_map<std::string, std::vector<GoalMask>> masks;
+
+			for (const auto& [id, states]: SUCCESS_STATES) {
+				for (const auto& state: states) {
+					masks[id].push_back(goalMask(state));
+				}
+			}
+
+			return masks;
+		}();
+
+		static const std::vector<GoalMask> NONE;
+		auto found = MASKS.find(target);
+
+		return (found != MASKS.end())? found->second : NONE;
+	}
+
+	/**
+	 * @brief Check if a board matches any of a set of success states
+	 * 
+	 * @param 	board 	The board to check
+	 * @param 	goals 	The success states, reduced to bit masks
+	 * @return 			`true` if the board matches at least one of them, `false` otherwise
+	 */
+	bool matchesAny(board_t board, const std::vector<GoalMask>& goals) {
+		for (const GoalMask& goal: goals) {
+			if (matchesMask(board, goal)) {
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	/**
+	 * @brief Estimate the number of moves needed to reach any of a set of success states
+	 * 
+	 * @param 	board 	The board to estimate from
+	 * @param 	goals 	The success states, reduced to bit masks
+	 * @return 			The same lower bound as the string overload, which is 0 only for a success state
+	 * 
+	 * @note 			The mismatched bits of each tile are folded onto its lowest bit, so a popcount gives the number
+	 * 					of mismatched tiles
+	 */
+	int lowerBound(board_t board, const std::vector<GoalMask>& goals) {
+		const board_t TILE_LOW_BITS = 0111111111;
+		int closest = 9;
+
+		for (const GoalMask& goal: goals) {
+			const board_t DIFFERENT = (board ^ goal.value) & goal.mask;
+			closest = std::min(closest, std::popcount((DIFFERENT | DIFFERENT >> 1 | DIFFERENT >> 2) & TILE_LOW_BITS));
+		}
+
+		return (closest + 1) / 2;
+	}
+}
@@ -0,0 +1,96 @@
+//
+// FILENAME: sweep.cpp | Shifting Stones Search
+// DESCRIPTION: Command line tool that reports how hard every card is from every starting board
+// CREATED: 2026-10-25 @ 11:20 AM
+//
+
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+
+#include "difficulty.hpp"
+#include "neighbors.hpp"
+
+/**
+ * @brief Sweep every card and store the reports
+ *
+ * @return The exit code
+ *
+ * @note   Usage: `SSSweep [--csv path] [--binary path] [--threads n] [--table path] [card...]`. Every card is swept
+ * 		   if none are given. An empty path skips that report.
+ */
+int main(int argc, char** argv) {
+	std::string csvPath = "sweep.csv", binaryPath = "sweep.bin", tablePath = neighbors::NEIGHBOR_FILE;
+	unsigned threads = 0;
+	std::vector<std::string> cards;
+
+	for (int i = 1; i < argc; i++) {
+		const std::string ARG = argv[i];
+		const bool HAS_VALUE = i + 1 < argc;
+
+		if (ARG == "--csv" && HAS_VALUE) {
+			csvPath = argv[++i];
+		}
+		else if (ARG == "--binary" && HAS_VALUE) {
+			binaryPath = argv[++i];
+		}
+		else if (ARG == "--threads" && HAS_VALUE) {
+			threads = std::strtoul(argv[++i], nullptr, 10);
+		}
+		else if (ARG == "--table" && HAS_VALUE) {
+			tablePath = argv[++i];
+		}
+		else if (ARG.starts_with("--")) {
+			std::cerr << "Usage: " << argv[0] << " [--csv path] [--binary path] [--threads n] [--table path] [card...]\n";
+			return EXIT_FAILURE;
+		}
+		else {
+			cards.push_back(ARG);
+		}
+	}
+
+	// Store a freshly built table so later runs can map it instead
+	const neighbors::NeighborTable* table = neighbors::sharedTable(tablePath);
+	if (!table) {
+		std::cerr << "The neighbor table was already loaded from another file\n";
+		return EXIT_FAILURE;
+	}
+	table->saveIfMissing(tablePath);
+
+	const auto START = std::chrono::steady_clock::now();
+	const std::vector<difficulty::CardReport> REPORTS = difficulty::sweep(*table, cards, threads);
+	const auto ELAPSED = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - START);
+
+	if (REPORTS.empty()) {
+		std::cerr << "No known cards to sweep\n";
+		return EXIT_FAILURE;
+	}
+
+	const difficulty::CardReport* hardest = &REPORTS[0];
+	for (const difficulty::CardReport& report: REPORTS) {
+		if (report.meanDistance > hardest->meanDistance) {
+			hardest = &report;
+		}
+	}
+
+	if (difficulty::overflows(REPORTS)) {
+		std::cerr << "Some boards need more than " << difficulty::MAX_DISTANCE << " moves, which the reports can't hold\n";
+		return EXIT_FAILURE;
+	}
+
+	std::cout << "Swept " << REPORTS.size() << " cards in " << ELAPSED.count() << " ms\n";
+	std::cout << "Hardest on average: " << hardest->card << " (" << hardest->meanDistance << " moves, " << hardest->maxDistance << " at worst)\n";
+
+	if (!csvPath.empty() && !difficulty::writeCSV(REPORTS, csvPath)) {
+		std::cerr << "Couldn't write " << csvPath << "\n";
+		return EXIT_FAILURE;
+	}
+
+	if (!binaryPath.empty() && !difficulty::writeBinary(REPORTS, binaryPath)) {
+		std::cerr << "Couldn't write " << binaryPath << "\n";
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,136 @@
+//
+// FILENAME: threadpool.cpp | Shifting Stones Search
+// DESCRIPTION: A work-stealing thread pool for background searches
+// CREATED: 2026-10-21 @ 10:20 AM
+//
+
+#include "threadpool.hpp"
+
+#include <algorithm>
+
+namespace threadpool {
+	namespace __detail {
+		/**
+		 * @brief The pool and queue of the calling thread, if it is a worker
+		 */
+		thread_local const ThreadPool* currentPool = nullptr;
+		thread_local std::size_t currentWorker = 0;
+	}
+
+	/**
+	 * @brief Start the workers
+	 *
+	 * @param 	threads The number of workers, or 0 for one per hardware thread
+	 */
+	ThreadPool::ThreadPool(unsigned threads) {
+		threads = threads? threads : std::max(1U, std::thread::hardware_concurrency());
+
+		for (unsigned t = 0; t < threads; t++) {
+			queues.push_back(std::make_unique<__worker_queue>());
+		}
+
+		for (unsigned t = 0; t < threads; t++) {
+			workers.emplace_back([this, t]() { run(t); });
+		}
+	}
+
+	/**
+	 * @brief Stop the workers
+	 *
+	 * @note  Tasks already queued are still run before the workers exit
+	 */
+	ThreadPool::~ThreadPool() {
+		{
+			std::lock_guard<std::mutex> guard(sleepLock);
+			stopping = true;
+		}
+
+		wake.notify_all();
+		workers.clear();
+	}
+
+	/**
+	 * @brief Queue a task
+	 *
+	 * @param 	task 	The task to run on one of the workers
+	 */
+	void ThreadPool::submit(task_t task) {
+		const bool LOCAL = __detail::currentPool == this;
+		const std::size_t QUEUE = LOCAL? __detail::currentWorker : nextQueue++ % queues.size();
+
+		{
+			// Counting the task first keeps the count from dropping below zero when it is taken right away, and taking
+			// the lock keeps it from changing between a worker's check and its wait
+			std::lock_guard<std::mutex> guard(sleepLock);
+			queued++;
+		}
+
+		{
+			std::lock_guard<std::mutex> guard(queues[QUEUE]->lock);
+
+			if (LOCAL) {
+				queues[QUEUE]->tasks.push_front(std::move(task));
+			} else {
+				queues[QUEUE]->tasks.push_back(std::move(task));
+			}
+		}
+
+		wake.notify_one();
+	}
+
+	/**
+	 * @brief Take the next task for a worker, stealing one if its own queue is empty
+	 *
+	 * @param 	worker 	The index of the worker
+	 * @param 	task 	Filled with the task taken
+	 * @return 			`true` if a task was taken, `false` if every queue was empty
+	 */
+	bool ThreadPool::take(std::size_t worker, task_t& task) {
+		for (std::size_t i = 0; i < queues.size(); i++) {
+			__worker_queue& queue = *queues[(worker + i) % queues.size()];
+			std::lock_guard<std::mutex> guard(queue.lock);
+
+			if (queue.tasks.empty()) {
+				continue;
+			}
+
+			if (i == 0) {
+				task = std::move(queue.tasks.front());
+				queue.tasks.pop_front();
+			} else {
+				task = std::move(queue.tasks.back());
+				queue.tasks.pop_back();
+			}
+
+			queued--;
+			return true;
+		}
+
+		return false;
+	}
+
+	/**
+	 * @brief The loop run by each worker
+	 *
+	 * @param 	worker 	The index of the worker
+	 */
+	void ThreadPool::run(std::size_t worker) {
+		__detail::currentPool = this;
+		__detail::currentWorker = worker;
+
+		for (task_t task;;) {
+			if (take(worker, task)) {
+				task();
+				task = nullptr;
+				continue;
+			}
+
+			std::unique_lock<std::mutex> guard(sleepLock);
+			wake.wait(guard, [this]() { return stopping || queued > 0; });
+
+			if (stopping && queued == 0) {
+				return;
+			}
+		}
+	}
+}
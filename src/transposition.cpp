@@ -0,0 +1,187 @@
+//
+// FILENAME: transposition.cpp | Shifting Stones Search
+// DESCRIPTION: A lock-free transposition table shared by search threads
+// CREATED: 2026-10-21 @ 2:15 PM
+//
+
+#include "transposition.hpp"
+
+#include <algorithm>
+#include <bit>
+
+namespace transposition {
+	namespace __detail {
+		/**
+		 * @brief The layout of a packed entry, from the lowest bit up:
+		 *
+		 * 		  | board (27) | card (7) | value (8) | bound (2) | move (5) | depth (6) | age (8) |
+		 */
+		const int CARD_SHIFT = 27;
+		const int VALUE_SHIFT = 34;
+		const int BOUND_SHIFT = 42;
+		const int MOVE_SHIFT = 44;
+		const int DEPTH_SHIFT = 49;
+		const int AGE_SHIFT = 55;
+
+		/**
+		 * @brief The bits identifying the (board, card) pair an entry belongs to
+		 */
+		const uint64_t KEY_MASK = (1ULL << VALUE_SHIFT) - 1;
+
+		inline uint64_t field(uint64_t word, int shift, int bits) {
+			return (word >> shift) & ((1ULL << bits) - 1);
+		}
+
+		inline uint64_t key(board_t board, int card) {
+			return (board & ((1ULL << USABLE_BOARD) - 1)) | (uint64_t)(card & 0x7F) << CARD_SHIFT;
+		}
+	}
+
+	/**
+	 * @brief Pack an entry into a single word
+	 *
+	 * @param 	entry 	The entry to pack. Out of range fields are truncated.
+	 * @return 			The packed entry
+	 */
+	uint64_t pack(const Entry& entry) {
+		return __detail::key(entry.board, entry.card)
+			| (uint64_t)(uint8_t)entry.value << __detail::VALUE_SHIFT
+			| (uint64_t)entry.bound << __detail::BOUND_SHIFT
+			| (uint64_t)(entry.move & 0x1F) << __detail::MOVE_SHIFT
+			| (uint64_t)(entry.depth & MAX_DEPTH) << __detail::DEPTH_SHIFT
+			| (uint64_t)entry.age << __detail::AGE_SHIFT;
+	}
+
+	/**
+	 * @brief Unpack an entry packed by `pack`
+	 *
+	 * @param 	word 	The packed entry
+	 * @return 			The entry
+	 */
+	Entry unpack(uint64_t word) {
+		Entry entry;
+		entry.board = __detail::field(word, 0, __detail::CARD_SHIFT);
+		entry.card = __detail::field(word, __detail::CARD_SHIFT, 7);
+		entry.value = (int8_t)__detail::field(word, __detail::VALUE_SHIFT, 8);
+		entry.bound = (Bound)__detail::field(word, __detail::BOUND_SHIFT, 2);
+		entry.move = __detail::field(word, __detail::MOVE_SHIFT, 5);
+		entry.depth = __detail::field(word, __detail::DEPTH_SHIFT, 6);
+		entry.age = __detail::field(word, __detail::AGE_SHIFT, 8);
+
+		return entry;
+	}
+
+	/**
+	 * @brief Allocate an empty table
+	 *
+	 * @param 	megabytes 	The size of the table. It is rounded down to a power of two number of buckets.
+	 */
+	TranspositionTable::TranspositionTable(std::size_t megabytes):
+		buckets(std::bit_floor(std::max<std::size_t>(1, (megabytes << 20) / sizeof(__bucket))))
+	{
+		table = std::make_unique<__bucket[]>(buckets);
+		clear();
+	}
+
+	/**
+	 * @brief Get the bucket a (board, card) pair hashes to
+	 */
+	TranspositionTable::__bucket& TranspositionTable::bucketFor(board_t board, int card) const {
+		// Fibonacci hashing spreads the neighboring keys of boards that differ by one move
+		const uint64_t HASH = __detail::key(board, card) * 0x9E3779B97F4A7C15ULL;
+		return table[(HASH >> 32) & (buckets - 1)];
+	}
+
+	/**
+	 * @brief Look up a (board, card) pair
+	 *
+	 * @param 	board 	The board to look up
+	 * @param 	card 	The index of the target card
+	 * @param 	entry 	Filled with the entry if one is found
+	 * @return 			`true` if the pair has an entry, `false` otherwise
+	 */
+	bool TranspositionTable::probe(board_t board, int card, Entry& entry) const {
+		const uint64_t KEY = __detail::key(board, card);
+		__bucket& bucket = bucketFor(board, card);
+
+		for (std::size_t i = 0; i < BUCKET_SIZE; i++) {
+			const uint64_t WORD = bucket.slots[i].load(std::memory_order_relaxed);
+
+			if ((WORD & __detail::KEY_MASK) == KEY && __detail::field(WORD, __detail::BOUND_SHIFT, 2) != (uint64_t)Bound::None) {
+				entry = unpack(WORD);
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	/**
+	 * @brief Record a search result
+	 *
+	 * @param 	board 	The board searched
+	 * @param 	card 	The index of the target card
+	 * @param 	value 	The value found
+	 * @param 	bound 	What the value says about the true value
+	 * @param 	move 	The best move found, or 0 if there is none
+	 * @param 	depth 	The remaining depth the board was searched to
+	 *
+	 * @note 			An existing entry for the pair is overwritten unless it is exact and the new one isn't.
+	 * 					Otherwise the entry replaced is the first empty one, then the one with the oldest generation,
+	 * 					then the one searched to the smallest depth.
+	 */
+	void TranspositionTable::store(board_t board, int card, int value, Bound bound, int move, int depth) {
+		const uint8_t AGE = generation();
+		const uint64_t KEY = __detail::key(board, card);
+		const uint64_t WORD = pack({board, card, value, bound, move, std::min(depth, MAX_DEPTH), AGE});
+		__bucket& bucket = bucketFor(board, card);
+
+		std::size_t victim = 0;
+		int victimScore = INT32_MAX;
+
+		for (std::size_t i = 0; i < BUCKET_SIZE; i++) {
+			const uint64_t CURRENT = bucket.slots[i].load(std::memory_order_relaxed);
+			const Bound CURRENT_BOUND = (Bound)__detail::field(CURRENT, __detail::BOUND_SHIFT, 2);
+
+			if (CURRENT_BOUND != Bound::None && (CURRENT & __detail::KEY_MASK) == KEY) {
+				if (CURRENT_BOUND != Bound::Exact || bound == Bound::Exact) {
+					bucket.slots[i].store(WORD, std::memory_order_relaxed);
+				}
+
+				return;
+			}
+
+			// Empty slots score lowest, then stale generations, then shallow searches
+			const int SCORE = (CURRENT_BOUND == Bound::None)? -1
+				: (__detail::field(CURRENT, __detail::AGE_SHIFT, 8) != AGE)? (int)__detail::field(CURRENT, __detail::DEPTH_SHIFT, 6)
+				: MAX_DEPTH + 1 + (int)__detail::field(CURRENT, __detail::DEPTH_SHIFT, 6);
+
+			if (SCORE < victimScore) {
+				victim = i;
+				victimScore = SCORE;
+			}
+		}
+
+		bucket.slots[victim].store(WORD, std::memory_order_relaxed);
+	}
+
+	/**
+	 * @brief Start a new generation, so entries from earlier searches are replaced first
+	 */
+	void TranspositionTable::newSearch() {
+		age.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	/**
+	 * @brief Remove every entry
+	 *
+	 * @note  Must not be called while other threads use the table
+	 */
+	void TranspositionTable::clear() {
+		for (std::size_t i = 0; i < buckets; i++) {
+			for (auto& slot: table[i].slots) {
+				slot.store(0, std::memory_order_relaxed);
+			}
+		}
+	}
+}
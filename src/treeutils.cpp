@@ -6,6 +6,12 @@
 
 #include "treeutils.hpp"
 
+#include <algorithm>
+#include <iterator>
+
+#include "faces.h"
+#include "policy.hpp"
+
 namespace treeutils {
 	/**
 	 * @brief Modify the board state
@@ -239,7 +245,49 @@ namespace treeutils {
 		return -1;
 	}
 
-	std::tuple<board_t, std::vector<int>> search(const tree_t tree, const std::string& target) {
+	/**
+	 * @brief Deal a random starting board
+	 * 
+	 * @param 	random 	The generator to draw from. Each thread should use its own.
+	 * @return 			A valid board. Every valid board is equally likely.
+	 * 
+	 * @note 			The nine stones are shuffled into place and each lands on a random face. The shuffle never
+	 * 					retries a draw, so every board takes the same small amount of work.
+	 */
+	board_t randomBoard(std::mt19937_64& random) {
+		// One stone of each pair, with the first face of each. Flipping a stone toggles its lowest bit.
+		Faces stones[] = {Sun, Fish, Fish, Seed, Seed, Seed, Horse, Horse, Horse};
+		const int NUM_TILES = sizeof(stones) / sizeof(stones[0]);
+
+		std::shuffle(std::begin(stones), std::end(stones), random);
+		const uint64_t FACES = random();
+		board_t board = 0;
+
+		for (int i = 0; i < NUM_TILES; i++) {
+			board |= (board_t)(stones[i] | ((FACES >> i) & 1)) << (24 - 3 * i);
+		}
+
+		return board;
+	}
+
+	/**
+	 * @brief Search a tree for the first board satisfying a target card
+	 * 
+	 * @param 	tree 		The tree to search
+	 * @param 	target 		The ID of the target card
+	 * @param 	policy 		An optional policy table built for `target`. When given, roots whose nearest success state
+	 * 						lies deeper than the tree are rejected before it is scanned.
+	 * @return 				The success state and its move set, or `0` and an empty move set if none was found
+	 */
+	std::tuple<board_t, std::vector<int>> search(const tree_t tree, const std::string& target, const policy::PolicyTable* policy) {
+		if (policy && policy->target() == target) {
+			const int ROOT = isValidBoardState(BOARD_IDX(tree, 0));
+
+			if (ROOT == -1 || policy->distance(ROOT) > TREE_GEN_HEIGHT) {
+				return std::make_tuple(0, std::vector<int>{});
+			}
+		}
+
 		const int TREE_NODES = TREE_NODES_COUNT(CHILDREN_PER_PARENT, TREE_GEN_HEIGHT);
 		//std::vector<__detail::__tree_node> nodes(TREE_NODES);
 		//nodes[0] = {0, 0, 0}; // Initialize the root node
@@ -257,14 +305,8 @@ namespace treeutils {
 			}
 
 			used[index] = true; // Mark the board as used
-			
-			std::cout << board << "\n";
-			std::cout << success_states::isSuccessState(board, target) << "\n";
-
-			//std::cout << "Valid: " << (index != -1) << "\n";
 
 			if (success_states::isSuccessState(board, target)) {
-				std::cout << "Found\n";
 				return std::make_tuple(board, makeMoveSet(tree, index));
 			}
 		}
@@ -428,17 +470,13 @@ namespace treeutils {
 		int rowIndex = 0;
 
 		while (rowIndex < TREE_GEN_HEIGHT) {
-			std::cout << rowIndex << "\n";
-
 			for (size_t i = 0; i < rowSize; i++) {
 				board_t board = BOARD_IDX(row, i);
 				//std::cout << board << "\n";
 				if (success_states::isSuccessState(board, successState)) {
-					std::cout << getBits(board, 27) << "\n";
 					return board;
 				}
 
-				std::cout << "Loading\n";
 				for (int j = 1; j <= CHILDREN_PER_PARENT; j++) {
 					BOARD(newRow, i, j) = __permuteBoard(board, j);
 					newRowSize++;
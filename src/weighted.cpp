@@ -0,0 +1,225 @@
+//
+// FILENAME: weighted.cpp | Shifting Stones Search
+// DESCRIPTION: Cheapest-cost search with small integer move costs
+// CREATED: 2026-10-23 @ 3:40 PM
+//
+
+#include "weighted.hpp"
+
+#include <algorithm>
+
+#include "boardstates.h"
+#include "successstates.hpp"
+#include "treeutils.hpp"
+
+namespace weighted {
+	namespace __detail {
+		/**
+		 * @brief The number of states settled between checks of the stop token and deadline
+		 */
+		const std::size_t CHECK_INTERVAL = 4096;
+
+		/**
+		 * @brief A monotone priority queue with one bucket per cost (Dial's algorithm)
+		 *
+		 * @note  Costs only grow as states are settled, so popping is a scan to the next non-empty bucket instead of a
+		 * 		  heap operation. Buckets are freed once they are passed. Zero-cost moves push into the bucket being
+		 * 		  read, which is read by position so the new entries are still seen.
+		 */
+		class __bucket_queue {
+		public:
+			void push(uint32_t state, uint32_t cost) {
+				if (cost >= buckets.size()) {
+					buckets.resize(cost + 1);
+				}
+
+				buckets[cost].push_back(state);
+			}
+
+			bool pop(uint32_t& state, uint32_t& cost) {
+				for (; current < buckets.size(); current++, position = 0) {
+					if (position < buckets[current].size()) {
+						state = buckets[current][position++];
+						cost = current;
+						return true;
+					}
+
+					std::vector<uint32_t>().swap(buckets[current]);
+				}
+
+				return false;
+			}
+
+		private:
+			std::vector<std::vector<uint32_t>> buckets;
+			std::size_t 					   current = 0; 	// The bucket being read
+			std::size_t 					   position = 0; 	// The next entry of the bucket being read
+		};
+	}
+
+	/**
+	 * @brief Make a cost table from a swap cost and a flip cost
+	 *
+	 * @param 	swapCost 	The cost of moves 1 - 12
+	 * @param 	flipCost 	The cost of moves 13 - 21
+	 * @return 				The cost table. Individual entries can be changed afterward for house rules.
+	 */
+	MoveCosts makeCosts(int swapCost, int flipCost) {
+		MoveCosts costs;
+
+		for (int move = 1; move <= (int)POSSIBLE_CONFIGS; move++) {
+			costs[move - 1] = std::clamp((move <= SWAP_MOVES)? swapCost : flipCost, 0, MAX_MOVE_COST);
+		}
+
+		return costs;
+	}
+
+	/**
+	 * @brief Find the cheapest solution to a single query
+	 *
+	 * @param 	board 	The starting board
+	 * @param 	target 	The ID of the target card
+	 * @param 	costs 	The cost of each move, from 0 to `MAX_MOVE_COST`
+	 * @param 	budget 	Limits on how much the search may do. `maxDepth` and `maxMemory` don't apply, since the
+	 * 					search's memory is fixed at about 3 bytes per state.
+	 * @param 	table 	An optional neighbor table
+	 * @return 			The solution. If the budget runs out first, the settled board with the smallest
+	 * 					`success_states::lowerBound` is returned instead, along with the cheapest moves leading to it.
+	 *
+	 * @note 			Success states are recognized when they are settled, not when they are reached, since a later
+	 * 					path to them can still be cheaper
+	 */
+	Solution solve(board_t board, const std::string& target, const MoveCosts& costs, const solver::Budget& budget, const neighbors::NeighborTable* table) {
+		Solution solution;
+		int root = treeutils::isValidBoardState(board);
+		auto card = success_states::SUCCESS_STATES.find(target);
+
+		if (root == -1 || card == success_states::SUCCESS_STATES.end()) {
+			return solution;
+		}
+
+		std::vector<uint16_t> cost(MAX_BOARD_STATES, UNREACHED);
+		std::vector<uint8_t> reachedBy(MAX_BOARD_STATES, 0); // The last move of the cheapest known path to each state
+		__detail::__bucket_queue queue;
+
+		cost[root] = 0;
+		reachedBy[root] = SOURCE_MOVE;
+		queue.push(root, 0);
+
+		uint32_t best = root;
+		int bestEstimate = success_states::lowerBound(board, card->second);
+
+		auto finish = [&](solver::Status status, uint32_t state) {
+			solution.status = status;
+			solution.board = BOARD_STATES[state];
+			solution.cost = cost[state];
+
+			// Every move is its own inverse, so the path is rebuilt by undoing the move that reached each state
+			for (; reachedBy[state] != SOURCE_MOVE; state = table? table->neighbor(state, reachedBy[state]) : neighbors::computeNeighbor(state, reachedBy[state])) {
+				solution.moves.push_back(reachedBy[state]);
+			}
+
+			std::reverse(solution.moves.begin(), solution.moves.end());
+			return solution;
+		};
+
+		std::size_t settled = 0;
+
+		for (uint32_t state, stateCost; queue.pop(state, stateCost);) {
+			// A cheaper path to the state was found after this entry was queued
+			if (stateCost > cost[state]) {
+				continue;
+			}
+
+			if (budget.maxNodes && settled >= budget.maxNodes) {
+				return finish(solver::Status::Exhausted, best);
+			}
+
+			if (settled++ % __detail::CHECK_INTERVAL == 0) {
+				if (budget.stop.stop_requested()) {
+					return finish(solver::Status::Cancelled, best);
+				}
+
+				if (solver::clock_type::now() >= budget.deadline) {
+					return finish(solver::Status::TimedOut, best);
+				}
+			}
+
+			if (const int ESTIMATE = success_states::lowerBound(BOARD_STATES[state], card->second); ESTIMATE < bestEstimate || ESTIMATE == 0) {
+				if (ESTIMATE == 0) {
+					return finish(solver::Status::Solved, state);
+				}
+
+				best = state;
+				bestEstimate = ESTIMATE;
+			}
+
+			for (int move = 1; move <= (int)POSSIBLE_CONFIGS; move++) {
+				const uint32_t NEXT = table? table->neighbor(state, move) : neighbors::computeNeighbor(state, move);
+				const uint32_t NEXT_COST = stateCost + costs[move - 1];
+
+				if (NEXT_COST < cost[NEXT]) {
+					cost[NEXT] = NEXT_COST;
+					reachedBy[NEXT] = move;
+					queue.push(NEXT, NEXT_COST);
+				}
+			}
+		}
+
+		return solution;
+	}
+
+	/**
+	 * @brief Find the cheapest cost from a set of sources to every state
+	 *
+	 * @param 	table 	A loaded neighbor table
+	 * @param 	sources The `BOARD_STATES` index of each source and the cost it starts with
+	 * @param 	costs 	The cost of each move, from 0 to `MAX_MOVE_COST`
+	 * @param 	reachedBy 	If given, filled with the last move of the cheapest path to each state, or `SOURCE_MOVE`
+	 * 						if the path starts there. Undoing these moves leads back to the source a state's cost
+	 * 						came from.
+	 * @return 			The cheapest cost of each state, or `UNREACHED`
+	 */
+	std::vector<uint16_t> distances(const neighbors::NeighborTable& table, const std::vector<std::pair<uint32_t, int>>& sources, const MoveCosts& costs, std::vector<uint8_t>* reachedBy) {
+		std::vector<uint16_t> cost(MAX_BOARD_STATES, UNREACHED);
+		__detail::__bucket_queue queue;
+
+		if (reachedBy) {
+			reachedBy->assign(MAX_BOARD_STATES, 0);
+		}
+
+		for (const auto& [source, offset]: sources) {
+			if (source < MAX_BOARD_STATES && offset >= 0 && offset < cost[source]) {
+				cost[source] = offset;
+				queue.push(source, offset);
+
+				if (reachedBy) {
+					(*reachedBy)[source] = SOURCE_MOVE;
+				}
+			}
+		}
+
+		for (uint32_t state, stateCost; queue.pop(state, stateCost);) {
+			if (stateCost > cost[state]) {
+				continue;
+			}
+
+			const uint32_t* row = table.row(state);
+
+			for (std::size_t move = 0; move < POSSIBLE_CONFIGS; move++) {
+				const uint32_t NEXT_COST = stateCost + costs[move];
+
+				if (NEXT_COST < cost[row[move]]) {
+					cost[row[move]] = NEXT_COST;
+					queue.push(row[move], NEXT_COST);
+
+					if (reachedBy) {
+						(*reachedBy)[row[move]] = move + 1;
+					}
+				}
+			}
+		}
+
+		return cost;
+	}
+}